@@ -47,6 +47,16 @@
 
 #define USENAME0 0
 
+/*----------------------------- MCF_STOP_EVERY -----------------------------*/
+/** How often SolveMCF() checks whether it has to stop [see MCFStop(),
+ * SetMCFToken() and SetMCFDeadline()]. The check is done once every
+ * MCF_STOP_EVERY calls to StopReq(), i.e., "iterations" of the main loop of
+ * the solver: it costs a few atomic loads and, if a deadline is set, the
+ * reading of the clock, hence it should not be done too often for solvers
+ * with very cheap iterations. */
+
+#define MCF_STOP_EVERY 64
+
 /** @} end( group( MCFCLASS_MACROS ) ) */ 
 /*--------------------------------------------------------------------------*/
 /*------------------------------ INCLUDES ----------------------------------*/
@@ -57,6 +67,8 @@
 /* OPTUtils.h defines standard interfaces for timing and random routines, as
    well as the namespace OPTtypes_di_unipi_it. */
 
+#include <atomic>
+#include <chrono>
 #include <iomanip>
 #include <sstream>
 #include <limits>
@@ -292,9 +304,12 @@ class MCFClass {
                   kEpsDfct ,         ///< tolerance for deficits
                   kEpsCst ,          ///< tolerance for costs
                   kReopt ,           ///< whether or not to reoptimize
+                  kTimeClock ,       ///< the clock used by the timer
                   kLastParam         /**< dummy parameter: this is used to
                                         allow derived classes to "extend"
-                                        the set of parameters. */
+                                        the set of parameters; hence, adding
+                                        a parameter here renumbers those of
+                                        all the derived classes. */
                   };
 
 /*--------------------------------------------------------------------------*/
@@ -336,6 +351,131 @@ class MCFClass {
 
  typedef MCFState *MCFStatePtr;  ///< pointer to a MCFState
 
+/*--------------------------------------------------------------------------*/
+/** Solver-independent description of a solution, used for warm starting a
+    MCF solver from the solution found by another one [see MCFGetWarmStart()
+    and MCFPutWarmStart() below]. X[] contains the NArcs arc flows and Pi[]
+    the NNodes node potentials, with the same meaning as in MCFGetX() and
+    MCFGetPi(). If Tree is not 0 it describes a spanning forest (typically,
+    the basis of a simplex solver): Tree[ i ] is the name of the arc joining
+    node i to its father, or Inf< Index >() if i is a root. Pi and/or Tree
+    can be 0 if that information is not available. The arrays belong to the
+    object and are deleted by its destructor, hence it cannot be copied
+    (it is always passed around by pointer or reference). */
+
+ class MCFWarmStart {
+ public:
+   MCFWarmStart( Index nn , Index mm , bool HasPi = true ,
+		 bool HasTree = false ) {
+    NNodes = nn;
+    NArcs = mm;
+    X = new FNumber[ mm ];
+    Pi = HasPi ? new CNumber[ nn ] : 0;
+    Tree = HasTree ? new Index[ nn ] : 0;
+    }
+
+   MCFWarmStart( const MCFWarmStart & ) = delete;
+
+   MCFWarmStart &operator=( const MCFWarmStart & ) = delete;
+
+   virtual ~MCFWarmStart() {
+    delete[] Tree;
+    delete[] Pi;
+    delete[] X;
+    }
+
+   Index NNodes;     ///< number of nodes
+   Index NArcs;      ///< number of arcs
+   FRow X;           ///< arc flows
+   CRow Pi;          ///< node potentials (possibly 0)
+   Index_Set Tree;   ///< father arc of each node (possibly 0)
+ };
+
+/*--------------------------------------------------------------------------*/
+/** Memory held by a MCF solver [see MCFGetMemory() below], in bytes, split
+    in four categories: the description of the graph (arc end nodes,
+    forward and backward stars, ...), the numeric data of the problem and
+    of its solution (costs, capacities, deficits, flows, potentials, ...),
+    the working data structures of the algorithm, and those only used by
+    optional features (allocated on demand, or only by some algorithms). */
+
+ class MCFMemory {
+ public:
+   MCFMemory( void ) : Topology( 0 ) , Data( 0 ) , Work( 0 ) , Extra( 0 ) {}
+
+   size_t Total( void ) const { return( Topology + Data + Work + Extra ); }
+
+   MCFMemory & operator+=( const MCFMemory &M ) {
+    Topology += M.Topology;
+    Data += M.Data;
+    Work += M.Work;
+    Extra += M.Extra;
+    return( *this );
+    }
+
+   size_t Topology;  ///< description of the graph
+   size_t Data;      ///< numeric data of the problem and of its solution
+   size_t Work;      ///< working data structures of the algorithm
+   size_t Extra;     ///< data structures of optional features
+ };
+
+/*--------------------------------------------------------------------------*/
+/** Thread-safe cancellation token [see SetMCFToken() below]. The same token
+    can be given to any number of solvers, possibly running in different
+    threads: calling Cancel() from any thread makes all of them stop as
+    soon as possible. The token is not reset by the solvers: this has to be
+    done with Cancel( false ) before it can be used again. */
+
+ class MCFToken {
+ public:
+   MCFToken( void ) : Cncl( false ) {}
+
+   void Cancel( bool Cn = true ) { Cncl.store( Cn ); }
+
+   bool Cancelled( void ) const {
+    return( Cncl.load( std::memory_order_relaxed ) );
+    }
+
+ private:
+   std::atomic< bool > Cncl;
+ };
+
+/** Absolute (wall-clock) time point [see SetMCFDeadline() below]. */
+
+ typedef std::chrono::steady_clock::time_point MCFTime;
+
+/** Read-only snapshot of the progress of SolveMCF(), passed to the callback
+    [see MCFCallback and SetMCFCallback() below]. The meaning of the
+    fields, and which of them are actually available (the others being
+    Inf< double >()), depends on the solver. */
+
+ class MCFProgress {
+ public:
+   long Iter;    ///< iterations done in the current call to SolveMCF()
+   FONumber FO;  ///< objective value of the current flow
+   double PInf;  ///< primal infeasibility of the current flow
+   double DInf;  ///< dual infeasibility of the current potentials
+ };
+
+/** Interface of the callback invoked by SolveMCF() [see SetMCFCallback()
+    below]. Progress() is called by the thread running SolveMCF() with the
+    solver itself and the current MCFProgress; by returning true it asks
+    SolveMCF() to stop, which then ends with MCFGetStatus() == kStopped
+    (and can be resumed as after MCFStop()). The solver must not be
+    changed within Progress(), but it can be queried, e.g. with
+    MCFGetX(), keeping in mind that the current solution is not optimal
+    and may not be feasible. Solvers wrapping others (e.g., MCFRecord,
+    MCFRace) pass the callback to them, so that S is the wrapped solver;
+    in particular, MCFRace calls Progress() concurrently from several
+    threads, hence a callback used with it must be thread-safe. */
+
+ class MCFCallback {
+ public:
+   virtual ~MCFCallback() {}
+
+   virtual bool Progress( const MCFClass &S , const MCFProgress &P ) = 0;
+ };
+
 /** @} ---------------------------------------------------------------------*/
 /*--------------------------- PUBLIC METHODS -------------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -379,6 +519,14 @@ class MCFClass {
   MaxIter = 0;
 
   MCFt = 0;
+  TClck = OPTtimers::kProcCPU;
+  StopRq = false;
+  Tkn = 0;
+  DeadLn = MCFTime::max();
+  StopCnt = 0;
+  CBck = 0;
+  CBEvry = 1;
+  CBCnt = 0;
   }
 
 
@@ -541,12 +689,32 @@ class MCFClass {
 	       optimization "from scratch" discarding any previous
 	       information. Usually reoptimization speeds up the computation
 	       considerably, but this is not always true, especially if the
-	       data of the problem changes a lot. */
+	       data of the problem changes a lot.
+
+   - kTimeClock: the clock read by TimeMCF( double & , double & ) and
+               TimeMCF( void ), and hence used for kMaxTime, among those of
+	       OPTtimers::OPTclock: wallclock time (kWall), CPU time of the
+	       thread (kThrdCPU) or CPU time of the process (kProcCPU,
+	       default). This has no effect unless OPT_TIMERS == 8 [see
+	       OPTUtils.h], as otherwise the timer only has one clock; any
+	       other value throws an exception. Note that reading either of
+	       the CPU clocks costs a system call (clock_gettime()), while
+	       the wallclock (std::chrono::steady_clock) is typically read
+	       without one; since solvers check kMaxTime by reading the timer
+	       once every few iterations, kWall should be preferred whenever
+	       a time limit is set and wallclock time is acceptable. */
 
  virtual void SetPar( int par , int val ) {
   switch( par ) {
    case( kMaxIter ): MaxIter = val; break;
    case( kReopt ):   Senstv = (val == kYes);  break;
+   case( kTimeClock ):
+    if( ( val < OPTtimers::kWall ) || ( val > OPTtimers::kProcCPU ) )
+     throw( MCFException( "MCFClass::SetPar: wrong kTimeClock" ) );
+    TClck = val;
+    if( MCFt )
+     MCFt->SetClock( TClck );
+    break;
    default: throw( MCFException( "Error: unknown parameter in SetPar" ) );
    }
   }
@@ -589,7 +757,11 @@ class MCFClass {
                is known to be ( eps * n )-optimal.
 
    - kMaxTime: sets the max time (in seconds) in which the MCF Solver can find
-               an optimal solution (default 0, which means no limit). */
+               an optimal solution (default 0, which means no limit). The
+	       time is that of the clock selected by kTimeClock [see
+	       SetPar( int , int )], and it is only checked if SetMCFTime()
+	       has been called; with the default CPU clock each check is a
+	       system call, hence selecting kWall makes it much cheaper. */
 
  virtual void SetPar( int par , double val ) {
   switch( par ) {
@@ -628,14 +800,15 @@ class MCFClass {
 
    @param val  upon return, it will contain the value of the parameter.
 
-   The base class implementation handles the parameters kMaxIter and kReopt.
-   */
+   The base class implementation handles the parameters kMaxIter, kReopt and
+   kTimeClock. */
 
  virtual void GetPar( int par , int &val ) const
  {
   switch( par ) {
    case( kMaxIter ): val = MaxIter; break;
    case( kReopt ):   val = Senstv ? kYes : kNo; break;
+   case( kTimeClock ): val = TClck; break;
    default: throw( MCFException( "GetPar: unknown parameter" ) );
    }
   }
@@ -679,17 +852,68 @@ class MCFClass {
 
  virtual void SetMCFTime( bool TimeIt = true )
  {
-  if( TimeIt )
+  if( TimeIt ) {
    if( MCFt )
     MCFt->ReSet();
    else
     MCFt = new OPTtimers();
+
+   MCFt->SetClock( TClck );
+   }
   else {
    delete MCFt;
    MCFt = 0;
    }
   }
 
+/*--------------------------------------------------------------------------*/
+/// set the cancellation token
+/** Gives the solver a cancellation token [see MCFToken above]: whenever
+   Tk->Cancel() is called, possibly by another thread, SolveMCF() stops as
+   soon as possible with MCFGetStatus() == kStopped. The token is not owned
+   by the solver, and must be alive until it is replaced by another one or
+   removed by SetMCFToken( 0 ) (the default). Unlike kMaxTime, this does not
+   need SetMCFTime(). */
+
+ void SetMCFToken( MCFToken *Tk = 0 ) { Tkn = Tk; }
+
+/*--------------------------------------------------------------------------*/
+/// set the absolute deadline
+/** Sets an absolute wall-clock deadline for SolveMCF(): when the time DL
+   is reached, SolveMCF() stops as soon as possible with MCFGetStatus() ==
+   kStopped. This is meant for requests having a time limit "upstream": the
+   deadline is the same for all the calls to SolveMCF(), and for all the
+   solvers given the same DL, unlike kMaxTime that is a relative time and
+   only counts the time spent within this solver. It is checked every
+   MCF_STOP_EVERY "iterations" [see StopReq()], hence it does not need
+   SetMCFTime(). The default MCFTime::max() means no deadline. */
+
+ void SetMCFDeadline( MCFTime DL = MCFTime::max() ) { DeadLn = DL; }
+
+/** Sets the deadline to Sec seconds from now. */
+
+ void SetMCFDeadline( double Sec ) {
+  DeadLn = std::chrono::steady_clock::now() +
+           std::chrono::duration_cast< std::chrono::steady_clock::duration >(
+				      std::chrono::duration< double >( Sec ) );
+  }
+
+/*--------------------------------------------------------------------------*/
+/// set the progress callback
+/** Sets the callback [see MCFCallback above] that SolveMCF() invokes once
+   every Every "iterations" of its main loop, for monitoring and for
+   implementing custom termination criteria. As a MCFProgress may cost
+   O( m ) to fill, Every should be chosen accordingly. The callback is not
+   owned by the solver; SetMCFCallback( 0 ) (the default) removes it, in
+   which case nothing is done at all. Solvers that do not support it just
+   ignore it. */
+
+ void SetMCFCallback( MCFCallback *CB = 0 , Index Every = 1 ) {
+  CBck = CB;
+  CBEvry = Every ? Every : 1;
+  CBCnt = 0;
+  }
+
 /** @} ---------------------------------------------------------------------*/
 /*---------------------- METHODS FOR SOLVING THE PROBLEM -------------------*/
 /*--------------------------------------------------------------------------*/
@@ -702,6 +926,23 @@ class MCFClass {
 
  virtual void SolveMCF( void ) = 0;
 
+/*--------------------------------------------------------------------------*/
+/// asks SolveMCF() to stop
+/** Asks SolveMCF() to stop as soon as possible, leaving MCFGetStatus() ==
+    kStopped. This can be called by another thread while SolveMCF() is
+    running, e.g. to stop the slower solvers in a race [see MCFRace.h]. The
+    request is "sticky": every subsequent call to SolveMCF() stops right
+    away until MCFStop( false ) is called. Solvers which do not check for
+    the request [see StopReq()] just ignore it. The method is virtual to
+    allow "composite" solvers to pass the request to their components.
+
+    When SolveMCF() is stopped in this way, or by a token [see SetMCFToken()]
+    or a deadline [see SetMCFDeadline()], the solvers keep their state
+    whenever possible: if the data of the problem is not changed, calling
+    SolveMCF() again resumes the solution process where it was stopped. */
+
+ virtual void MCFStop( bool Stop = true ) { StopRq.store( Stop ); }
+
 /*--------------------------------------------------------------------------*/
 /// returns the solution status
 /** Returns an int describing the current status of the MCF solver. Possible
@@ -1057,6 +1298,58 @@ class MCFClass {
 
  virtual void MCFPutState( MCFStatePtr /*S*/ ) {}
 
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/// export the current solution for warm starting another solver
+/** Unlike MCFGetState(), whose result is only meaningful for the very solver
+    that produced it, MCFGetWarmStart() creates and returns a solver-neutral
+    MCFWarmStart object [see above] describing the current solution, which
+    can be passed to MCFPutWarmStart() of any MCF solver (of any class)
+    having the same nodes and arcs; e.g., the problem can be solved with a
+    fast solver first, then moved to one providing more information (say, a
+    basis) about the optimal solution, or the solvers can be alternated as
+    the instance evolves. As for MCFGetState(), the returned object has to be
+    deleted on the outside when no longer needed.
+
+    The base class provides an implementation that only fills flows and
+    potentials by means of MCFGetX() and MCFGetPi(), which is correct for any
+    solver; derived classes may override it to provide a basis as well. */
+
+ virtual MCFWarmStart *MCFGetWarmStart( void ) const {
+  MCFWarmStart *WS = new MCFWarmStart( n , m );
+  MCFGetX( WS->X );
+  MCFGetPi( WS->Pi );
+  return( WS );
+  }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/// warm start the solver from a solution found by (possibly) another one
+/** Uses the information in WS, typically produced by MCFGetWarmStart() of
+    (possibly) another MCF solver on the same network, as the starting point
+    of the next call to SolveMCF(). WS is not modified and can be deleted as
+    soon as the method returns. The solution in WS need not be optimal, nor
+    even feasible, for the current data: each solver uses as much of it as it
+    can, and the result of SolveMCF() is not affected (apart from the time it
+    takes). Since not all the MCF solvers can take advantage of such an
+    information, an "empty" implementation that does nothing is provided by
+    the base class. */
+
+ virtual void MCFPutWarmStart( const MCFWarmStart & /*WS*/ ) {}
+
+/** @} ---------------------------------------------------------------------*/
+/** @name Memory footprint
+ *  @{ */
+
+/// return the memory held by the solver
+/** Returns the memory (in bytes) currently held by the solver, split by
+    category [see MCFMemory], so that e.g. the solver, and the values of
+    nmax and mmax passed to LoadNet(), can be chosen within a given memory
+    budget. Only the memory depending on the size of the instance is
+    counted, not the (fixed) size of the object itself, nor the temporaries
+    that only live within one call. Since the base class cannot know it, it
+    returns all zeros, which has to be read as "unknown". */
+
+ virtual MCFMemory MCFGetMemory( void ) const { return( MCFMemory() ); }
+
 /** @} ---------------------------------------------------------------------*/
 /** @name Time the code
  *  @{ */
@@ -1088,6 +1381,22 @@ class MCFClass {
 
  double TimeMCF( void ) const { return( MCFt ? MCFt->Read() : 0 ); }
 
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/// Like TimeMCF( double , double ), but separately for each clock
+/** Like TimeMCF( double , double ) [see above], but returns separately the
+    wallclock time in t_wl, the CPU time of the thread in t_th and the CPU
+    time of the process in t_pr, irrespective of kTimeClock [see SetPar()].
+    If OPT_TIMERS != 8 [see OPTUtils.h] only one of them is available, the
+    others being 0. The CPU time of the thread is only meaningful if the
+    timed methods are all called by the same thread. */
+
+ void TimeMCF( double &t_wl , double &t_th , double &t_pr ) const
+ {
+  t_wl = t_th = t_pr = 0;
+  if( MCFt )
+   MCFt->Read( t_wl , t_th , t_pr );
+  }
+
 /** @} ---------------------------------------------------------------------*/
 /** @name Check the solutions
  *  @{ */
@@ -1739,6 +2048,53 @@ class MCFClass {
 
 /*--------------------------------------------------------------------------*/
 /*--------------------------- PROTECTED METHODS ----------------------------*/
+/*--------------------------------------------------------------------------*/
+/** true if SolveMCF() has to stop, because MCFStop() has been called, or
+    the token has been cancelled, or the deadline has passed. It is meant to
+    be called at each iteration of the main loop of SolveMCF(), that then
+    ends with kStopped; to make it cheap, the actual check is only done once
+    every MCF_STOP_EVERY calls. */
+
+ bool StopReq( void )
+ {
+  if( StopCnt ) {
+   StopCnt--;
+   return( false );
+   }
+
+  StopCnt = MCF_STOP_EVERY - 1;
+  return( StopNow() );
+  }
+
+/** true if the callback [see SetMCFCallback()] has to be invoked at this
+    iteration of the main loop of SolveMCF(). Only if so the solver should
+    fill a MCFProgress and pass it to CBck->Progress(), ending with kStopped
+    if it returns true; hence, with no callback the cost is that of testing
+    a pointer. */
+
+ bool CBckDue( void )
+ {
+  if( ( ! CBck ) || ( ++CBCnt < CBEvry ) )
+   return( false );
+
+  CBCnt = 0;
+  return( true );
+  }
+
+/** Like StopReq(), but the check is always done. */
+
+ bool StopNow( void ) const
+ {
+  if( StopRq.load( std::memory_order_relaxed ) )
+   return( true );
+
+  if( Tkn && Tkn->Cancelled() )
+   return( true );
+
+  return( ( DeadLn != MCFTime::max() ) &&
+	  ( std::chrono::steady_clock::now() >= DeadLn ) );
+  }
+
 /*--------------------------------------------------------------------------*/
 /*-------------------------- MANAGING COMPARISONS --------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -1850,6 +2206,7 @@ class MCFClass {
  bool Senstv;  ///< true <=> the latest optimal solution should be exploited
 
  OPTtimers *MCFt;   ///< timer for performances evaluation
+ int TClck;         ///< the clock read by MCFt [see kTimeClock]
 
  FNumber EpsFlw;   ///< precision for comparing arc flows / capacities
  FNumber EpsDfct;  ///< precision for comparing node deficits
@@ -1860,6 +2217,15 @@ class MCFClass {
  int MaxIter;      ///< max number of iterations in which MCF Solver can find 
                    ///< an optimal solution (0 = no limits)
 
+ std::atomic< bool > StopRq;  ///< true <=> MCFStop() has been called
+ MCFToken *Tkn;               ///< the cancellation token (if any)
+ MCFTime DeadLn;              ///< the deadline (MCFTime::max() = none)
+ int StopCnt;                 ///< calls to StopReq() before the next check
+
+ MCFCallback *CBck;  ///< the progress callback (if any)
+ Index CBEvry;       ///< iterations between two calls to CBck
+ Index CBCnt;        ///< iterations since the latest call to CBck
+
 /*--------------------------------------------------------------------------*/
 
   };   // end( class MCFClass )
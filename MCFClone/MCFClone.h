@@ -135,6 +135,15 @@ class MCFClone : public Master {
     return( Master::TimeMCF() + SlvMCF->TimeMCF() );
     }
 
+/*--------------------------------------------------------------------------*/
+/** The memory held by both solvers. */
+
+   MCFClass::MCFMemory MCFGetMemory( void ) const override {
+    MCFClass::MCFMemory M = Master::MCFGetMemory();
+    M += SlvMCF->MCFGetMemory();
+    return( M );
+    }
+
 /*--------------------------------------------------------------------------*/
 /*-------------- METHODS FOR READING THE DATA OF THE PROBLEM ---------------*/
 /*--------------------------------------------------------------------------*/
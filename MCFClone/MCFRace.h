@@ -0,0 +1,531 @@
+/*--------------------------------------------------------------------------*/
+/*--------------------------- File MCFRace.h -------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Portfolio "solver" for Min Cost Flow Problems deriving from MCFClass. It
+ * holds any number of "real" solvers (all deriving from MCFClass), gives
+ * all of them the same instance and the same changes, and solves them in
+ * parallel threads: the first one finishing wins, the others are stopped,
+ * and the results are those of the winner.
+ *
+ * \author Antonio Frangioni \n
+ *         Dipartimento di Informatica \n
+ *         Universita' di Pisa \n
+ *
+ * \copyright &copy; by Antonio Frangioni
+ */
+/*--------------------------------------------------------------------------*/
+/*----------------------------- DEFINITIONS --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#ifndef __MCFRace
+ #define __MCFRace  /* self-identification: #endif at the end of the file */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ INCLUDES ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#include "MCFClass.h"
+
+#include <exception>
+#include <mutex>
+#include <vector>
+
+/*--------------------------------------------------------------------------*/
+/*------------------------- NAMESPACE and USING ----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+namespace MCFClass_di_unipi_it
+{
+ using namespace OPTtypes_di_unipi_it;
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------- CLASS MCFRace --------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** MCFRace derives from MCFClass and runs a "race" among several Min Cost
+ * Flow Problem solvers deriving from MCFClass. Like MCFClone, it does
+ * whatever it is asked to on all of them; but SolveMCF() runs all the
+ * solvers at the same time, each in its own thread. The first one that
+ * ends with a "final" answer (kOK, kUnfeasible or kUnbounded) is the
+ * winner, and all the others are asked to stop with MCFStop(); all the
+ * methods reading the results then read them from the winner. This is
+ * useful since no solver is the best on all the instances, and which one
+ * is best for a given instance is often not easy to guess.
+ *
+ * All the solvers always have the same instance, so the methods reading
+ * the data of the problem just read them from the first one. Note that
+ * the solvers are not stopped before the end of their current "iteration"
+ * [see MCFStop()], so some of them may still be running a little when the
+ * winner is found; SolveMCF() returns when all of them have stopped.
+ *
+ * The callback, if any [see SetMCFCallback()], is passed to all the
+ * solvers, hence its Progress() is called concurrently by all the threads
+ * of the race, each time with its own solver as the first argument: it
+ * must therefore be thread-safe. Returning true stops only the solver
+ * that made the call. */
+
+class MCFRace : public MCFClass {
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PUBLIC PART OF THE CLASS -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ public:
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------- PUBLIC METHODS -------------------------------*/
+/*--------------------------------------------------------------------------*/
+/*---------------------------- CONSTRUCTOR ---------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** Constructor of the class: the solvers are added with AddSolver(). */
+
+   MCFRace( cIndex nmx = 0 , cIndex mmx = 0 ) : MCFClass( nmx , mmx ) {
+    Wnr = 0;
+    }
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- OTHER INITIALIZATIONS -------------------------*/
+/*--------------------------------------------------------------------------*/
+/** Adds the solver S to the race. It has to be called before LoadNet(),
+    unless S already has the same instance as the others. If Own == true
+    S is deleted by the destructor of MCFRace, otherwise this is up to the
+    caller. Solvers that do not support MCFStop() can be added, but then the
+    race lasts at least as long as they do. */
+
+   void AddSolver( MCFClass *S , bool Own = true ) {
+    if( ! S )
+     throw( MCFException( "MCFRace::AddSolver: null solver" ) );
+
+    Slvs.push_back( S );
+    Owns.push_back( Own );
+    }
+
+/*--------------------------------------------------------------------------*/
+
+   void LoadNet( Index nmx = 0 , Index mmx = 0 , Index pn = 0 ,
+		 Index pm = 0 , cFRow pU = 0 , cCRow pC = 0 ,
+		 cFRow pDfct = 0 , cIndex_Set pSn = 0 ,
+		 cIndex_Set pEn = 0 ) override;
+
+/*--------------------------------------------------------------------------*/
+
+   void PreProcess( void ) override {
+    for( auto S : Slvs )
+     S->PreProcess();
+    }
+
+/*--------------------------------------------------------------------------*/
+/** Only the parameters of the base class (those < kLastParam) are passed to
+    all the solvers, as the others mean different things to each of them:
+    these have to be set on each solver directly [see Solver()]. */
+
+   void SetPar( int par , int val ) override {
+    MCFClass::SetPar( par , val );
+    if( par < kLastParam )
+     for( auto S : Slvs )
+      S->SetPar( par , val );
+    }
+
+   void SetPar( int par , double val ) override {
+    MCFClass::SetPar( par , val );
+    if( par < kLastParam )
+     for( auto S : Slvs )
+      S->SetPar( par , val );
+    }
+
+/*--------------------------------------------------------------------------*/
+
+   void SetMCFTime( bool TimeIt = true ) override {
+    MCFClass::SetMCFTime( TimeIt );
+    for( auto S : Slvs )
+     S->SetMCFTime( TimeIt );
+    }
+
+/*--------------------------------------------------------------------------*/
+/*---------------------- METHODS FOR SOLVING THE PROBLEM -------------------*/
+/*--------------------------------------------------------------------------*/
+/** Runs SolveMCF() of all the solvers in parallel, the first one in the
+    calling thread. If none of them gets a "final" answer, the results are
+    those of the first solver that has not thrown an exception; if all of
+    them have, the exception of the first one is re-thrown. */
+
+   void SolveMCF( void ) override;
+
+/*--------------------------------------------------------------------------*/
+/** Also passes the request to all the solvers. */
+
+   void MCFStop( bool Stop = true ) override {
+    MCFClass::MCFStop( Stop );
+    for( auto S : Slvs )
+     S->MCFStop( Stop );
+    }
+
+/*--------------------------------------------------------------------------*/
+/*---------------------- METHODS FOR READING RESULTS -----------------------*/
+/*--------------------------------------------------------------------------*/
+/** All the results are those of the winner of the latest race. */
+
+   void MCFGetX( FRow F , Index_Set nms = 0 , Index strt = 0 ,
+		 Index stp = Inf< Index >() ) const override {
+    Slvs[ Wnr ]->MCFGetX( F , nms , strt , stp );
+    }
+
+   cFRow MCFGetX( void ) const override { return( Slvs[ Wnr ]->MCFGetX() ); }
+
+   bool HaveNewX( void ) override { return( Slvs[ Wnr ]->HaveNewX() ); }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void MCFGetPi( CRow P , cIndex_Set nms = 0 , Index strt = 0 ,
+		  Index stp = Inf< Index >() ) const override {
+    Slvs[ Wnr ]->MCFGetPi( P , nms , strt , stp );
+    }
+
+   cCRow MCFGetPi( void ) const override {
+    return( Slvs[ Wnr ]->MCFGetPi() );
+    }
+
+   bool HaveNewPi( void ) override { return( Slvs[ Wnr ]->HaveNewPi() ); }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void MCFGetRC( CRow CR , cIndex_Set nms = 0 , Index strt = 0 ,
+		  Index stp = Inf< Index >() ) const override {
+    Slvs[ Wnr ]->MCFGetRC( CR , nms , strt , stp );
+    }
+
+   cCRow MCFGetRC( void ) const override {
+    return( Slvs[ Wnr ]->MCFGetRC() );
+    }
+
+   CNumber MCFGetRC( Index i ) const override {
+    return( Slvs[ Wnr ]->MCFGetRC( i ) );
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   FONumber MCFGetFO( void ) const override {
+    return( Slvs[ Wnr ]->MCFGetFO() );
+    }
+
+   FONumber MCFGetDFO( void ) const override {
+    return( Slvs[ Wnr ]->MCFGetDFO() );
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   FNumber MCFGetUnfCut( Index_Set Cut ) const override {
+    return( Slvs[ Wnr ]->MCFGetUnfCut( Cut ) );
+    }
+
+   Index MCFGetUnbCycl( Index_Set Pred , Index_Set ArcPred ) const override {
+    return( Slvs[ Wnr ]->MCFGetUnbCycl( Pred , ArcPred ) );
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/** The states [see MCFGetState()] are specific of each solver, hence they
+    are not supported; the solver-neutral warm starts are taken from the
+    winner and given to all the solvers. */
+
+   MCFWarmStart *MCFGetWarmStart( void ) const override {
+    return( Slvs[ Wnr ]->MCFGetWarmStart() );
+    }
+
+   void MCFPutWarmStart( const MCFWarmStart &WS ) override {
+    for( auto S : Slvs )
+     S->MCFPutWarmStart( WS );
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/** The memory held by all the solvers, each of which has its own copy of
+    the instance. */
+
+   MCFMemory MCFGetMemory( void ) const override {
+    MCFMemory M;
+    for( auto S : Slvs )
+     M += S->MCFGetMemory();
+    return( M );
+    }
+
+/*--------------------------------------------------------------------------*/
+/*-------------- METHODS FOR READING THE DATA OF THE PROBLEM ---------------*/
+/*--------------------------------------------------------------------------*/
+
+   void MCFArcs( Index_Set Startv , Index_Set Endv , cIndex_Set nms = 0 ,
+		 Index strt = 0 , Index stp = Inf< Index >() )
+    const override {
+    Slvs[ 0 ]->MCFArcs( Startv , Endv , nms , strt , stp );
+    }
+
+   Index MCFSNde( Index i ) const override {
+    return( Slvs[ 0 ]->MCFSNde( i ) );
+    }
+
+   Index MCFENde( Index i ) const override {
+    return( Slvs[ 0 ]->MCFENde( i ) );
+    }
+
+   cIndex_Set MCFSNdes( void ) const override {
+    return( Slvs[ 0 ]->MCFSNdes() );
+    }
+
+   cIndex_Set MCFENdes( void ) const override {
+    return( Slvs[ 0 ]->MCFENdes() );
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void MCFCosts( CRow Costv , cIndex_Set nms = 0 , Index strt = 0 ,
+		  Index stp = Inf< Index >() ) const override {
+    Slvs[ 0 ]->MCFCosts( Costv , nms , strt , stp );
+    }
+
+   CNumber MCFCost( Index i ) const override {
+    return( Slvs[ 0 ]->MCFCost( i ) );
+    }
+
+   cCRow MCFCosts( void ) const override { return( Slvs[ 0 ]->MCFCosts() ); }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void MCFQCoef( CRow Qv , cIndex_Set nms = 0 , Index strt = 0 ,
+		  Index stp = Inf< Index >() ) const override {
+    Slvs[ 0 ]->MCFQCoef( Qv , nms , strt , stp );
+    }
+
+   CNumber MCFQCoef( Index i ) const override {
+    return( Slvs[ 0 ]->MCFQCoef( i ) );
+    }
+
+   cCRow MCFQCoef( void ) const override { return( Slvs[ 0 ]->MCFQCoef() ); }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void MCFUCaps( FRow UCapv , cIndex_Set nms = 0 , Index strt = 0 ,
+		  Index stp = Inf< Index >() ) const override {
+    Slvs[ 0 ]->MCFUCaps( UCapv , nms , strt , stp );
+    }
+
+   FNumber MCFUCap( Index i ) const override {
+    return( Slvs[ 0 ]->MCFUCap( i ) );
+    }
+
+   cFRow MCFUCaps( void ) const override { return( Slvs[ 0 ]->MCFUCaps() ); }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void MCFDfcts( FRow Dfctv , cIndex_Set nms = 0 , Index strt = 0 ,
+		  Index stp = Inf< Index >() ) const override {
+    Slvs[ 0 ]->MCFDfcts( Dfctv , nms , strt , stp );
+    }
+
+   FNumber MCFDfct( Index i ) const override {
+    return( Slvs[ 0 ]->MCFDfct( i ) );
+    }
+
+   cFRow MCFDfcts( void ) const override { return( Slvs[ 0 ]->MCFDfcts() ); }
+
+/*--------------------------------------------------------------------------*/
+/*------------- METHODS FOR ADDING / REMOVING / CHANGING DATA --------------*/
+/*--------------------------------------------------------------------------*/
+
+   void ChgCosts( cCRow NCost , cIndex_Set nms = 0 ,
+		  Index strt = 0 , Index stp = Inf< Index >() ) override {
+    for( auto S : Slvs )
+     S->ChgCosts( NCost , nms , strt , stp );
+
+    status = kUnSolved;
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void ChgCost( Index arc , CNumber NCost ) override {
+    for( auto S : Slvs )
+     S->ChgCost( arc , NCost );
+
+    status = kUnSolved;
+    }
+
+/*--------------------------------------------------------------------------*/
+
+   void ChgQCoef( cCRow NQCoef = 0 , cIndex_Set nms = 0 ,
+		  Index strt = 0 , Index stp = Inf< Index >() ) override {
+    for( auto S : Slvs )
+     S->ChgQCoef( NQCoef , nms , strt , stp );
+
+    status = kUnSolved;
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void ChgQCoef( Index arc , CNumber NQCoef ) override {
+    for( auto S : Slvs )
+     S->ChgQCoef( arc , NQCoef );
+
+    status = kUnSolved;
+    }
+
+/*--------------------------------------------------------------------------*/
+
+   void ChgUCaps( cFRow NCap , cIndex_Set nms = 0 ,
+		  Index strt = 0 , Index stp = Inf< Index >() ) override {
+    for( auto S : Slvs )
+     S->ChgUCaps( NCap , nms , strt , stp );
+
+    status = kUnSolved;
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void ChgUCap( Index arc , FNumber NCap ) override {
+    for( auto S : Slvs )
+     S->ChgUCap( arc , NCap );
+
+    status = kUnSolved;
+    }
+
+/*--------------------------------------------------------------------------*/
+
+   void ChgDfcts( cFRow NDfct , cIndex_Set nms = 0 ,
+		  Index strt = 0 , Index stp = Inf< Index >() ) override {
+    for( auto S : Slvs )
+     S->ChgDfcts( NDfct , nms , strt , stp );
+
+    status = kUnSolved;
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void ChgDfct( Index node , FNumber NDfct ) override {
+    for( auto S : Slvs )
+     S->ChgDfct( node , NDfct );
+
+    status = kUnSolved;
+    }
+
+/*--------------------------------------------------------------------------*/
+
+   void CloseArc( Index name ) override {
+    for( auto S : Slvs )
+     S->CloseArc( name );
+
+    status = kUnSolved;
+    }
+
+   bool IsClosedArc( Index name ) const override {
+    return( Slvs[ 0 ]->IsClosedArc( name ) );
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void OpenArc( Index name ) override {
+    for( auto S : Slvs )
+     S->OpenArc( name );
+
+    status = kUnSolved;
+    }
+
+/*--------------------------------------------------------------------------*/
+
+   void DelNode( Index name ) override {
+    for( auto S : Slvs )
+     S->DelNode( name );
+
+    Sync();
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   Index AddNode( FNumber aDfct ) override;
+
+/*--------------------------------------------------------------------------*/
+
+   void ChangeArc( Index name , Index nSN = Inf< Index >() ,
+		   Index nEN = Inf< Index >() ) override {
+    for( auto S : Slvs )
+     S->ChangeArc( name , nSN , nEN );
+
+    status = kUnSolved;
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void DelArc( Index name ) override {
+    for( auto S : Slvs )
+     S->DelArc( name );
+
+    Sync();
+    }
+
+   bool IsDeletedArc( Index name ) const override {
+    return( Slvs[ 0 ]->IsDeletedArc( name ) );
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   Index AddArc( Index Start , Index End , FNumber aU , CNumber aC )
+    override;
+
+/*--------------------------------------------------------------------------*/
+/*------------------------ SPECIFIC METHODS --------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** Returns the number of solvers in the race. */
+
+   Index NSolvers( void ) const { return( Index( Slvs.size() ) ); }
+
+/** Returns a pointer to the i-th solver (in the order of AddSolver()), e.g.
+    to call the methods of its specialized interface. */
+
+   MCFClass *Solver( Index i ) const { return( Slvs[ i ] ); }
+
+/** Returns the index (as in Solver()) of the winner of the latest race. */
+
+   Index Winner( void ) const { return( Wnr ); }
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ DESTRUCTOR --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   ~MCFRace() override;
+
+/*--------------------------------------------------------------------------*/
+/*-------------------- PRIVATE PART OF THE CLASS ---------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ private:
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- PRIVATE METHODS -------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   void Run( Index i );
+
+   void Sync( void );
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PRIVATE DATA STRUCTURES  -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   std::vector< MCFClass * > Slvs;  // the solvers
+   std::vector< bool > Owns;        // Owns[ i ] <=> Slvs[ i ] is deleted
+
+   Index Wnr;                       // the winner of the latest race
+   std::mutex Mtx;                  // protects Wnr during the race
+   std::vector< std::exception_ptr > Errs;  // exceptions during the race
+
+/*--------------------------------------------------------------------------*/
+
+ };   // end( class MCFRace )
+
+/*--------------------------------------------------------------------------*/
+
+};  // end( namespace MCFClass_di_unipi_it )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#endif  /* MCFRace.h included */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------- End File MCFRace.h -----------------------------*/
+/*--------------------------------------------------------------------------*/
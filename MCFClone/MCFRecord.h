@@ -0,0 +1,600 @@
+/*--------------------------------------------------------------------------*/
+/*-------------------------- File MCFRecord.h ------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Recording "solver" for Min Cost Flow Problems deriving from MCFClass. It
+ * holds one "real" solver (deriving from MCFClass), does whatever it is
+ * asked to on it, and meanwhile writes all the calls that change the
+ * problem or the solver, with their arguments, to a compact binary trace;
+ * the trace can later be replayed on any solver with MCFRecord::Replay().
+ *
+ * \author Antonio Frangioni \n
+ *         Dipartimento di Informatica \n
+ *         Universita' di Pisa \n
+ *
+ * \copyright &copy; by Antonio Frangioni
+ */
+/*--------------------------------------------------------------------------*/
+/*----------------------------- DEFINITIONS --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#ifndef __MCFRecord
+ #define __MCFRecord  /* self-identification: #endif at the end of the file */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ INCLUDES ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#include "MCFClass.h"
+
+#include <iostream>
+#include <vector>
+
+/*--------------------------------------------------------------------------*/
+/*------------------------- NAMESPACE and USING ----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+namespace MCFClass_di_unipi_it
+{
+ using namespace OPTtypes_di_unipi_it;
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- CLASS MCFRecord -------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** MCFRecord derives from MCFClass and is a "decorator" of one Min Cost
+ * Flow Problem solver deriving from MCFClass: like MCFClone, it passes to
+ * it whatever it is asked to, and all the results are read from it. In
+ * addition, all the calls that change the problem (LoadNet(), and hence
+ * LoadDMX(), Chg*(), CloseArc(), OpenArc(), AddNode(), DelNode(), AddArc(),
+ * DelArc(), ChangeArc()) or the solver (SetPar(), PreProcess(),
+ * MCFPutWarmStart(), SolveMCF()) are written, with all their arguments, to
+ * a trace on a std::ostream. This allows to reproduce "offline" a sequence
+ * of calls built incrementally by some application: the trace can be
+ * re-issued to any solver with Replay(), so that e.g. it can be profiled,
+ * or the solvers can be compared, on exactly the same sequence.
+ *
+ * The trace is binary, in the native representation of the numbers of the
+ * platform, hence it can only be replayed by a program compiled with the
+ * same Index, FNumber and CNumber types on a platform with the same
+ * endianness (which Replay() checks). The parameters are written as raw
+ * ints, and adding one to MCFClass renumbers those of all the derived
+ * classes, hence the trace also records kLastParam, and Replay() rejects
+ * those recorded with a different one. Each call costs one byte for its
+ * type plus the raw bytes of its arguments, and the arrays passed to the
+ * Chg*() methods are only written for the entries that are actually
+ * changed. The stream is flushed just before each SolveMCF(), so that the
+ * trace is complete even if the program never gets out of it; after
+ * SolveMCF() returns the status, the objective value and the (wall-clock)
+ * solution time are also written, for Replay() to compare with.
+ *
+ * The calls that depend on the timing of the application rather than on
+ * the problem, such as MCFStop() or SetMCFToken(), are not written, and
+ * neither is MCFPutState(), since the states are solver-specific. */
+
+class MCFRecord : public MCFClass {
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PUBLIC PART OF THE CLASS -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ public:
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- PUBLIC TYPES --------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** Information about the outcome of Replay() [see below]. */
+
+ class MCFReplayInfo {
+ public:
+   Index NCalls;                ///< number of calls re-issued
+   Index NMis;                  ///< SolveMCF() with a different result
+   std::vector< double > Time;  ///< wall-clock time of each SolveMCF()
+   std::vector< double > RTim;  /**< the same, as recorded in the trace
+				   (-1 if the trace ends within it) */
+ };
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------- PUBLIC METHODS -------------------------------*/
+/*--------------------------------------------------------------------------*/
+/*---------------------------- CONSTRUCTOR ---------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** Constructor of the class: S is the solver, and the trace is written to
+    Trc, that must be open in binary mode and survive the MCFRecord. If
+    Own == true S is deleted by the destructor of MCFRecord, otherwise this
+    is up to the caller. S should have no instance yet, i.e., LoadNet()
+    should be called on the MCFRecord, or the trace cannot be replayed. */
+
+   MCFRecord( MCFClass *S , std::ostream &Trc , bool Own = true );
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- OTHER INITIALIZATIONS -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   void LoadNet( Index nmx = 0 , Index mmx = 0 , Index pn = 0 ,
+		 Index pm = 0 , cFRow pU = 0 , cCRow pC = 0 ,
+		 cFRow pDfct = 0 , cIndex_Set pSn = 0 ,
+		 cIndex_Set pEn = 0 ) override;
+
+/*--------------------------------------------------------------------------*/
+
+   void PreProcess( void ) override {
+    Put( char( kOpPreP ) );
+    Slv->PreProcess();
+    status = kUnSolved;
+    }
+
+/*--------------------------------------------------------------------------*/
+/** All the parameters are passed to the solver and recorded; Replay() only
+    re-issues those of the derived classes (>= kLastParam) if the
+    solver it is given is of the same type as the recorded one. */
+
+   void SetPar( int par , int val ) override;
+
+   void SetPar( int par , double val ) override;
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void GetPar( int par , int &val ) const override {
+    Slv->GetPar( par , val );
+    }
+
+   void GetPar( int par , double &val ) const override {
+    Slv->GetPar( par , val );
+    }
+
+/*--------------------------------------------------------------------------*/
+
+   void SetMCFTime( bool TimeIt = true ) override {
+    MCFClass::SetMCFTime( TimeIt );
+    Slv->SetMCFTime( TimeIt );
+    }
+
+/*--------------------------------------------------------------------------*/
+/*---------------------- METHODS FOR SOLVING THE PROBLEM -------------------*/
+/*--------------------------------------------------------------------------*/
+
+   void SolveMCF( void ) override;
+
+/*--------------------------------------------------------------------------*/
+/** Also passes the request to the solver. */
+
+   void MCFStop( bool Stop = true ) override {
+    MCFClass::MCFStop( Stop );
+    Slv->MCFStop( Stop );
+    }
+
+/*--------------------------------------------------------------------------*/
+/*---------------------- METHODS FOR READING RESULTS -----------------------*/
+/*--------------------------------------------------------------------------*/
+/** All the results are those of the recorded solver. */
+
+   void MCFGetX( FRow F , Index_Set nms = 0 , Index strt = 0 ,
+		 Index stp = Inf< Index >() ) const override {
+    Slv->MCFGetX( F , nms , strt , stp );
+    }
+
+   cFRow MCFGetX( void ) const override { return( Slv->MCFGetX() ); }
+
+   bool HaveNewX( void ) override { return( Slv->HaveNewX() ); }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void MCFGetPi( CRow P , cIndex_Set nms = 0 , Index strt = 0 ,
+		  Index stp = Inf< Index >() ) const override {
+    Slv->MCFGetPi( P , nms , strt , stp );
+    }
+
+   cCRow MCFGetPi( void ) const override {
+    return( Slv->MCFGetPi() );
+    }
+
+   bool HaveNewPi( void ) override { return( Slv->HaveNewPi() ); }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void MCFGetRC( CRow CR , cIndex_Set nms = 0 , Index strt = 0 ,
+		  Index stp = Inf< Index >() ) const override {
+    Slv->MCFGetRC( CR , nms , strt , stp );
+    }
+
+   cCRow MCFGetRC( void ) const override {
+    return( Slv->MCFGetRC() );
+    }
+
+   CNumber MCFGetRC( Index i ) const override {
+    return( Slv->MCFGetRC( i ) );
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   FONumber MCFGetFO( void ) const override {
+    return( Slv->MCFGetFO() );
+    }
+
+   FONumber MCFGetDFO( void ) const override {
+    return( Slv->MCFGetDFO() );
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   FNumber MCFGetUnfCut( Index_Set Cut ) const override {
+    return( Slv->MCFGetUnfCut( Cut ) );
+    }
+
+   Index MCFGetUnbCycl( Index_Set Pred , Index_Set ArcPred ) const override {
+    return( Slv->MCFGetUnbCycl( Pred , ArcPred ) );
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/** The states [see MCFGetState()] are passed to and from the recorded
+    solver, but MCFPutState() is *not* recorded, as they are specific of
+    each solver and cannot be written in the trace; the solver-neutral warm
+    starts are, instead [see MCFPutWarmStart()]. */
+
+   MCFStatePtr MCFGetState( void ) const override {
+    return( Slv->MCFGetState() );
+    }
+
+   void MCFPutState( MCFStatePtr S ) override {
+    Slv->MCFPutState( S );
+    status = kUnSolved;
+    }
+
+   MCFWarmStart *MCFGetWarmStart( void ) const override {
+    return( Slv->MCFGetWarmStart() );
+    }
+
+   void MCFPutWarmStart( const MCFWarmStart &WS ) override;
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   MCFMemory MCFGetMemory( void ) const override {
+    return( Slv->MCFGetMemory() );
+    }
+
+/*--------------------------------------------------------------------------*/
+/*-------------- METHODS FOR READING THE DATA OF THE PROBLEM ---------------*/
+/*--------------------------------------------------------------------------*/
+
+   void MCFArcs( Index_Set Startv , Index_Set Endv , cIndex_Set nms = 0 ,
+		 Index strt = 0 , Index stp = Inf< Index >() )
+    const override {
+    Slv->MCFArcs( Startv , Endv , nms , strt , stp );
+    }
+
+   Index MCFSNde( Index i ) const override {
+    return( Slv->MCFSNde( i ) );
+    }
+
+   Index MCFENde( Index i ) const override {
+    return( Slv->MCFENde( i ) );
+    }
+
+   cIndex_Set MCFSNdes( void ) const override {
+    return( Slv->MCFSNdes() );
+    }
+
+   cIndex_Set MCFENdes( void ) const override {
+    return( Slv->MCFENdes() );
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void MCFCosts( CRow Costv , cIndex_Set nms = 0 , Index strt = 0 ,
+		  Index stp = Inf< Index >() ) const override {
+    Slv->MCFCosts( Costv , nms , strt , stp );
+    }
+
+   CNumber MCFCost( Index i ) const override {
+    return( Slv->MCFCost( i ) );
+    }
+
+   cCRow MCFCosts( void ) const override { return( Slv->MCFCosts() ); }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void MCFQCoef( CRow Qv , cIndex_Set nms = 0 , Index strt = 0 ,
+		  Index stp = Inf< Index >() ) const override {
+    Slv->MCFQCoef( Qv , nms , strt , stp );
+    }
+
+   CNumber MCFQCoef( Index i ) const override {
+    return( Slv->MCFQCoef( i ) );
+    }
+
+   cCRow MCFQCoef( void ) const override { return( Slv->MCFQCoef() ); }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void MCFUCaps( FRow UCapv , cIndex_Set nms = 0 , Index strt = 0 ,
+		  Index stp = Inf< Index >() ) const override {
+    Slv->MCFUCaps( UCapv , nms , strt , stp );
+    }
+
+   FNumber MCFUCap( Index i ) const override {
+    return( Slv->MCFUCap( i ) );
+    }
+
+   cFRow MCFUCaps( void ) const override { return( Slv->MCFUCaps() ); }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void MCFDfcts( FRow Dfctv , cIndex_Set nms = 0 , Index strt = 0 ,
+		  Index stp = Inf< Index >() ) const override {
+    Slv->MCFDfcts( Dfctv , nms , strt , stp );
+    }
+
+   FNumber MCFDfct( Index i ) const override {
+    return( Slv->MCFDfct( i ) );
+    }
+
+   cFRow MCFDfcts( void ) const override { return( Slv->MCFDfcts() ); }
+
+/*--------------------------------------------------------------------------*/
+/*------------- METHODS FOR ADDING / REMOVING / CHANGING DATA --------------*/
+/*--------------------------------------------------------------------------*/
+/** All of them are passed to the solver and recorded. */
+
+   void ChgCosts( cCRow NCost , cIndex_Set nms = 0 ,
+		  Index strt = 0 , Index stp = Inf< Index >() ) override {
+    PutChg( kOpCsts , NCost , nms , strt , stp , m );
+    Slv->ChgCosts( NCost , nms , strt , stp );
+    status = kUnSolved;
+    }
+
+   void ChgCost( Index arc , CNumber NCost ) override {
+    Put( char( kOpCst ) );
+    Put( arc );
+    Put( NCost );
+    Slv->ChgCost( arc , NCost );
+    status = kUnSolved;
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void ChgQCoef( cCRow NQCoef = 0 , cIndex_Set nms = 0 ,
+		  Index strt = 0 , Index stp = Inf< Index >() ) override {
+    PutChg( kOpQCfs , NQCoef , nms , strt , stp , m );
+    Slv->ChgQCoef( NQCoef , nms , strt , stp );
+    status = kUnSolved;
+    }
+
+   void ChgQCoef( Index arc , CNumber NQCoef ) override {
+    Put( char( kOpQCf ) );
+    Put( arc );
+    Put( NQCoef );
+    Slv->ChgQCoef( arc , NQCoef );
+    status = kUnSolved;
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void ChgUCaps( cFRow NCap , cIndex_Set nms = 0 ,
+		  Index strt = 0 , Index stp = Inf< Index >() ) override {
+    PutChg( kOpCaps , NCap , nms , strt , stp , m );
+    Slv->ChgUCaps( NCap , nms , strt , stp );
+    status = kUnSolved;
+    }
+
+   void ChgUCap( Index arc , FNumber NCap ) override {
+    Put( char( kOpCap ) );
+    Put( arc );
+    Put( NCap );
+    Slv->ChgUCap( arc , NCap );
+    status = kUnSolved;
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void ChgDfcts( cFRow NDfct , cIndex_Set nms = 0 ,
+		  Index strt = 0 , Index stp = Inf< Index >() ) override {
+    PutChg( kOpDfcs , NDfct , nms , strt , stp , n );
+    Slv->ChgDfcts( NDfct , nms , strt , stp );
+    status = kUnSolved;
+    }
+
+   void ChgDfct( Index node , FNumber NDfct ) override {
+    Put( char( kOpDfc ) );
+    Put( node );
+    Put( NDfct );
+    Slv->ChgDfct( node , NDfct );
+    status = kUnSolved;
+    }
+
+/*--------------------------------------------------------------------------*/
+
+   void CloseArc( Index name ) override {
+    Put( char( kOpClse ) );
+    Put( name );
+    Slv->CloseArc( name );
+    status = kUnSolved;
+    }
+
+   bool IsClosedArc( Index name ) const override {
+    return( Slv->IsClosedArc( name ) );
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void OpenArc( Index name ) override {
+    Put( char( kOpOpen ) );
+    Put( name );
+    Slv->OpenArc( name );
+    status = kUnSolved;
+    }
+
+/*--------------------------------------------------------------------------*/
+
+   void DelNode( Index name ) override {
+    Put( char( kOpDelN ) );
+    Put( name );
+    Slv->DelNode( name );
+    Sync();
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/** The name of the new node is recorded as well: Replay() fails if the
+    solver it is given chooses a different one. */
+
+   Index AddNode( FNumber aDfct ) override;
+
+/*--------------------------------------------------------------------------*/
+
+   void ChangeArc( Index name , Index nSN = Inf< Index >() ,
+		   Index nEN = Inf< Index >() ) override {
+    Put( char( kOpChgA ) );
+    Put( name );
+    Put( nSN );
+    Put( nEN );
+    Slv->ChangeArc( name , nSN , nEN );
+    status = kUnSolved;
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void DelArc( Index name ) override {
+    Put( char( kOpDelA ) );
+    Put( name );
+    Slv->DelArc( name );
+    Sync();
+    }
+
+   bool IsDeletedArc( Index name ) const override {
+    return( Slv->IsDeletedArc( name ) );
+    }
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+/** The name of the new arc is recorded as well: Replay() fails if the
+    solver it is given chooses a different one. */
+
+   Index AddArc( Index Start , Index End , FNumber aU , CNumber aC )
+    override;
+
+/*--------------------------------------------------------------------------*/
+/*------------------------ SPECIFIC METHODS --------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** Returns a pointer to the recorded solver, e.g. to call the methods of
+    its specialized interface (which are not recorded). */
+
+   MCFClass *Solver( void ) const { return( Slv ); }
+
+/*--------------------------------------------------------------------------*/
+/** Re-issues to mcf all the calls recorded in the trace read from Trc,
+    which must be open in binary mode, in the same order; mcf must have no
+    instance yet. The trace can be incomplete, e.g. if the recording program
+    has been killed within a SolveMCF(), in which case the last SolveMCF()
+    is still re-issued. If Info != 0 it is filled with the number of calls,
+    the wall-clock times of the SolveMCF() and those recorded in the trace,
+    and the number of them after which the status of mcf, or its objective
+    value (up to a relative 1e-9), differ from the recorded ones. Throws
+    MCFException if the trace is not valid or has been recorded with
+    different types or a different kLastParam. */
+
+   static void Replay( std::istream &Trc , MCFClass &mcf ,
+		       MCFReplayInfo *Info = 0 );
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ DESTRUCTOR --------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** Flushes the trace, and deletes the solver if it is owned. */
+
+   ~MCFRecord() override;
+
+/*--------------------------------------------------------------------------*/
+/*-------------------- PRIVATE PART OF THE CLASS ---------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ private:
+
+/*--------------------------------------------------------------------------*/
+/*----------------------------- PRIVATE TYPES ------------------------------*/
+/*--------------------------------------------------------------------------*/
+// the calls in the trace, each written as one char followed by its
+// arguments [see the implementation of Replay() for the details]
+
+   enum MCFOp { kOpLoad = 1 , kOpPreP , kOpParI , kOpParD , kOpWStr ,
+		kOpSlve , kOpRslt , kOpCsts , kOpCst , kOpQCfs , kOpQCf ,
+		kOpCaps , kOpCap , kOpDfcs , kOpDfc , kOpClse , kOpOpen ,
+		kOpDelN , kOpAddN , kOpChgA , kOpDelA , kOpAddA };
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- PRIVATE METHODS -------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   template< class T >
+   void Put( const T &v ) {
+    Trc.write( reinterpret_cast< const char * >( &v ) , sizeof( T ) );
+    }
+
+   template< class T >
+   void Put( const T *v , Index k ) {
+    if( k )
+     Trc.write( reinterpret_cast< const char * >( v ) , k * sizeof( T ) );
+    }
+
+   // the Chg*() are written in one of two forms, told apart by the bit 1
+   // of a format char: either the number of changed names, the names and
+   // the new values, or strt, stp (not larger than mx) and the stp - strt
+   // new values; the bit 2 of the format char tells if the new values are
+   // there at all
+
+   template< class T >
+   void PutChg( char op , const T *v , cIndex_Set nms , Index strt ,
+		Index stp , Index mx ) {
+    if( stp > mx )
+     stp = mx;
+
+    Put( op );
+    if( nms ) {
+     for( ; *nms < strt ; nms++ )  // skip the names before strt, as the
+      if( v )                      // solvers do
+       v++;
+
+     Index k = 0;
+     while( nms[ k ] < stp )
+      k++;
+
+     Put( char( v ? 3 : 1 ) );
+     Put( k );
+     Put( nms , k );
+     if( v )
+      Put( v , k );
+     }
+    else {
+     if( strt > stp )
+      strt = stp;
+
+     Put( char( v ? 2 : 0 ) );
+     Put( strt );
+     Put( stp );
+     if( v )
+      Put( v , stp - strt );
+     }
+    }
+
+   void Sync( void );
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PRIVATE DATA STRUCTURES  -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   MCFClass *Slv;       // the solver
+   bool Own;            // true if Slv is deleted by the destructor
+   std::ostream &Trc;   // the trace
+
+/*--------------------------------------------------------------------------*/
+
+ };   // end( class MCFRecord )
+
+/*--------------------------------------------------------------------------*/
+
+};  // end( namespace MCFClass_di_unipi_it )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#endif  /* MCFRecord.h included */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------ End File MCFRecord.h ----------------------------*/
+/*--------------------------------------------------------------------------*/
@@ -292,6 +292,13 @@ class MCFCplex: public MCFClass {
 
   FONumber MCFGetFO( void ) const override;
 
+/*--------------------------------------------------------------------------*/
+/** Same meaning as MCFClass::MCFGetMemory(), but only the memory allocated
+   by MCFCplex itself is reported: that held by Cplex for the problem, which
+   is most of it, is not known, and therefore it is not counted. */
+
+  MCFMemory MCFGetMemory( void ) const override;
+
 /*--------------------------------------------------------------------------*/
 /*---------- METHODS FOR READING THE DATA OF THE PROBLEM -------------------*/
 /*--------------------------------------------------------------------------*/
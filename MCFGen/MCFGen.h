@@ -0,0 +1,323 @@
+/*--------------------------------------------------------------------------*/
+/*---------------------------- File MCFGen.h -------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Generator of random Min Cost Flow instances, in the style of the classic
+ * NETGEN, GRIDGEN and GOTO generators, plus transportation and assignment
+ * problems. The instances are reproducible (the same parameters and seed
+ * always give the same instance, on any platform), and they can either be
+ * loaded directly into any solver deriving from MCFClass or written in
+ * DIMACS format; in the latter case the arcs are never stored, so that
+ * instances with hundreds of millions of arcs can be produced.
+ *
+ * \author Antonio Frangioni \n
+ *         Dipartimento di Informatica \n
+ *         Universita' di Pisa \n
+ *
+ * \copyright &copy; by Antonio Frangioni
+ */
+/*--------------------------------------------------------------------------*/
+/*----------------------------- DEFINITIONS --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#ifndef __MCFGen
+ #define __MCFGen  /* self-identification: #endif at the end of the file */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ INCLUDES ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#include "MCFClass.h"
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/*--------------------------------------------------------------------------*/
+/*------------------------- NAMESPACE and USING ----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+namespace MCFClass_di_unipi_it
+{
+ using namespace OPTtypes_di_unipi_it;
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------- CLASS MCFGen ---------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** MCFGen generates random Min Cost Flow instances belonging to a few
+ * well-known families [see MCFGenFamily], which are meant to be used for
+ * benchmarking the solvers on instances much larger than those that can be
+ * reasonably shipped with the code. The generators follow the structure of
+ * the classical ones, but they are not bit-for-bit compatible with them:
+ * in particular, a portable 64-bit pseudo-random generator is used, so that
+ * the instance only depends on the parameters and on the seed.
+ *
+ * All the instances are feasible by construction: each family has a
+ * "skeleton" of arcs, whose capacity is large enough to carry all the flow
+ * (an arc is "uncapacitated" if its capacity is the total supply), to
+ * which random arcs are added up to the required number. All costs and
+ * capacities are integer. Node names go from 1 to n, as in DIMACS.
+ *
+ * The arcs are produced one by one and given to a MCFGenSink, so that they
+ * need not be stored: LoadNet() uses a sink that builds the arrays needed
+ * by MCFClass::LoadNet(), WriteDMX() one that writes them on a stream. */
+
+class MCFGen {
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PUBLIC PART OF THE CLASS -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ public:
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- PUBLIC TYPES --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ typedef MCFClass::Index     Index;      ///< index of a node or arc
+ typedef MCFClass::cIndex    cIndex;     ///< a read-only Index
+ typedef MCFClass::FNumber   FNumber;    ///< type of flows and deficits
+ typedef MCFClass::cFNumber  cFNumber;   ///< a read-only FNumber
+ typedef MCFClass::FRow      FRow;       ///< vector of FNumber
+ typedef MCFClass::cFRow     cFRow;      ///< a read-only FRow
+ typedef MCFClass::CNumber   CNumber;    ///< type of arc costs
+ typedef MCFClass::cCNumber  cCNumber;   ///< a read-only CNumber
+
+/** The families of instances that can be generated. The number of nodes
+    and arcs given to the constructor [see SetSize()] may be slightly
+    changed to fit the structure of the family, as described below. */
+
+ enum MCFGenFamily {
+  kNetgen = 0 ,  /**< NETGEN-style: NSrc sources, NSnk sinks and the rest
+		      transshipment nodes; the skeleton is made of a random
+		      path from each source through a random subset of the
+		      transshipment nodes to a random sink, the other arcs
+		      join random pairs of nodes. Requires m >= n - NSnk. */
+  kGridgen ,     /**< GRIDGEN-style: the nodes are a grid with Width
+		      columns [see SetWidth()], n being rounded down to a
+		      multiple of it; the skeleton are the (uncapacitated)
+		      arcs in both directions between adjacent nodes, the
+		      other arcs join random pairs of nodes. NSrc sources and
+		      NSnk sinks are random nodes. */
+  kGoto ,        /**< GOTO-style ("Grid On TOrus"): the nodes are a grid
+		      with Width columns whose borders wrap around, each node
+		      having the same number ( m / n , at least 2 ) of
+		      outgoing arcs: the skeleton are the two arcs to the
+		      next node in the row and in the column, which are
+		      uncapacitated but have the maximum cost, the others go
+		      to random "nearby" nodes and have a cost increasing
+		      with the distance. There is only one source, the first
+		      node, and one sink, the node in the middle of the
+		      torus. */
+  kTransp ,      /**< transportation: NSrc sources and n - NSrc sinks, all
+		      the arcs go from a source to a sink; the skeleton is
+		      the (uncapacitated) "north-west corner" solution. */
+  kAssign        /**< assignment: transportation with n / 2 sources and
+		      n / 2 sinks, all with unit supply / demand, and unit
+		      capacities; the skeleton is the matching of source i
+		      with sink i. */
+  };
+
+/*--------------------------------------------------------------------------*/
+/** Consumer of the instance produced by Generate(): Nodes() is called once
+    at the beginning, then Arc() is called once for each arc. */
+
+ class MCFGenSink {
+ public:
+   virtual ~MCFGenSink() {}
+
+   /// the instance has n nodes and m arcs, with deficits Dfct[ 0 .. n - 1 ]
+   virtual void Nodes( Index n , Index m , cFRow Dfct ) = 0;
+
+   /// the next arc goes from node t to node h (names in 1 .. n)
+   virtual void Arc( Index t , Index h , FNumber u , CNumber c ) = 0;
+ };
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- CONSTRUCTOR ---------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** Constructor of the class: builds a generator for instances of family
+    Fmly [see MCFGenFamily] with (about) nn nodes and mm arcs, using the
+    seed Sd. The other parameters have the following defaults:
+
+    - one source and one sink for kNetgen and kGridgen, n / 10 sources for
+      kTransp [see SetSrcSnk()];
+
+    - total supply 1000 * max( NSrc , NSnk ) [see SetSupply()];
+
+    - costs in [ 1 , 10000 ] [see SetCost()];
+
+    - capacities of the non-skeleton arcs in [ 1 , 1000 ] [see SetUCap()];
+
+    - square grids [see SetWidth()]. */
+
+ MCFGen( int Fmly = kNetgen , Index nn = 1000 , Index mm = 10000 ,
+	 uint64_t Sd = 1 ) {
+  SetFamily( Fmly );
+  SetSize( nn , mm );
+  SetSeed( Sd );
+  NSrc = NSnk = 0;
+  Sply = 0;
+  CMin = 1;
+  CMax = 10000;
+  UMin = 1;
+  UMax = 1000;
+  Width = 0;
+  }
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- OTHER INITIALIZATIONS -------------------------*/
+/*--------------------------------------------------------------------------*/
+/// sets the family of the instances [see MCFGenFamily]
+
+ void SetFamily( int Fmly ) {
+  if( ( Fmly < kNetgen ) || ( Fmly > kAssign ) )
+   throw( MCFClass::MCFException( "MCFGen::SetFamily: unknown family" ) );
+
+  Fam = Fmly;
+  }
+
+/// sets the (approximate) number of nodes and arcs [see MCFGenFamily]
+
+ void SetSize( Index nn , Index mm ) { n = nn; m = mm; }
+
+/// sets the seed of the random generator
+
+ void SetSeed( uint64_t Sd ) { Seed = Sd; }
+
+/** Sets the number of sources and sinks; 0 means the default. The number
+    of sinks is ignored by kTransp, both are ignored by kGoto and kAssign. */
+
+ void SetSrcSnk( Index ns , Index nt ) { NSrc = ns; NSnk = nt; }
+
+/** Sets the total supply (= total demand); 0 means the default. It is
+    ignored by kAssign. */
+
+ void SetSupply( FNumber S ) { Sply = S; }
+
+/// sets the range of the (integer) arc costs
+
+ void SetCost( CNumber Mn , CNumber Mx ) { CMin = Mn; CMax = Mx; }
+
+/// sets the range of the (integer) capacities of the non-skeleton arcs
+
+ void SetUCap( FNumber Mn , FNumber Mx ) { UMin = Mn; UMax = Mx; }
+
+/** Sets the number of columns of the grid of kGridgen and kGoto; 0 (the
+    default) means about sqrt( n ). */
+
+ void SetWidth( Index w ) { Width = w; }
+
+/*--------------------------------------------------------------------------*/
+/*------------------------ GENERATING THE INSTANCE -------------------------*/
+/*--------------------------------------------------------------------------*/
+/** Generates the instance and gives it to Snk. Only the deficits of the
+    nodes are stored in the meantime, so the memory required is O( n )
+    (plus whatever Snk does). An exception is thrown if the parameters are
+    not consistent. */
+
+ void Generate( MCFGenSink &Snk );
+
+/*--------------------------------------------------------------------------*/
+/** Generates the instance and loads it into mcf with MCFClass::LoadNet();
+    nmx and mmx are passed to it as the maximum number of nodes and arcs,
+    if they are larger than those of the instance. */
+
+ void LoadNet( MCFClass &mcf , Index nmx = 0 , Index mmx = 0 );
+
+/*--------------------------------------------------------------------------*/
+/** Generates the instance and writes it on os in DIMACS format, with a
+    comment line describing the parameters used to generate it. */
+
+ void WriteDMX( std::ostream &os );
+
+/*--------------------------------------------------------------------------*/
+/*-------------------- PRIVATE PART OF THE CLASS ---------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ private:
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- PRIVATE METHODS -------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ void Netgen( MCFGenSink &Snk );
+ void Gridgen( MCFGenSink &Snk );
+ void Goto( MCFGenSink &Snk );
+ void Transp( MCFGenSink &Snk );
+ void Assign( MCFGenSink &Snk );
+
+ // splits Tot in k random nonnegative integer parts, written in v
+ void Split( FRow v , Index k , FNumber Tot );
+
+ // the "north-west corner" solution of the transportation problem with
+ // supplies Sup[ 0 .. ns - 1 ] and demands Dem[ 0 .. nt - 1 ]: its arcs are
+ // given to Snk (if any), and their number is returned
+ Index NWCorner( cFRow Sup , Index ns , cFRow Dem , Index nt ,
+		 MCFGenSink *Snk );
+
+ // the next pseudo-random number (SplitMix64) of the stream with state S
+ static uint64_t Next( uint64_t &S ) {
+  uint64_t z = ( S += 0x9E3779B97F4A7C15ULL );
+  z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+  z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+  return( z ^ ( z >> 31 ) );
+  }
+
+ // a pseudo-random number uniformly distributed in [ 0 , 1 )
+ double Rand( void ) {
+  return( double( Next( St ) >> 11 ) / 9007199254740992.0 );  // 2^53
+  }
+
+ // a pseudo-random integer uniformly distributed in [ 0 , k ) (k > 0)
+ Index Rand( Index k ) { return( Index( Next( St ) % uint64_t( k ) ) ); }
+
+ // a random integer in [ Mn , Mx ] from the stream of costs and capacities
+ double RData( double Mn , double Mx ) {
+  return( Mn + double( Next( CSt ) % ( uint64_t( Mx - Mn ) + 1 ) ) );
+  }
+
+ // a random cost in [ CMin , CMax ] and a random capacity in [ UMin , UMax ]
+ CNumber RCost( void ) { return( CNumber( RData( CMin , CMax ) ) ); }
+
+ FNumber RUCap( void ) { return( FNumber( RData( UMin , UMax ) ) ); }
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PRIVATE DATA STRUCTURES  -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ int Fam;          // the family of the instances
+ Index n;          // (required) number of nodes
+ Index m;          // (required) number of arcs
+ uint64_t Seed;    // the seed
+ uint64_t St;      // state of the random stream for the structure
+ uint64_t CSt;     // state of the random stream for costs and capacities
+
+ Index NSrc;       // number of sources
+ Index NSnk;       // number of sinks
+ FNumber Sply;     // total supply
+ FNumber TSply;    // total supply actually used (the default is computed)
+ CNumber CMin;     // minimum cost
+ CNumber CMax;     // maximum cost
+ FNumber UMin;     // minimum capacity
+ FNumber UMax;     // maximum capacity
+ Index Width;      // number of columns of grids
+
+ std::vector< FNumber > Dfct;  // deficits of the nodes in Generate()
+
+/*--------------------------------------------------------------------------*/
+
+ };   // end( class MCFGen )
+
+/*--------------------------------------------------------------------------*/
+
+};  // end( namespace MCFClass_di_unipi_it )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#endif  /* MCFGen.h included */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------- End File MCFGen.h ------------------------------*/
+/*--------------------------------------------------------------------------*/
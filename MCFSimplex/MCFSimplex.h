@@ -43,7 +43,7 @@ namespace MCFClass_di_unipi_it
 /*-------------------------------- MACROS ----------------------------------*/
 /*--------------------------------------------------------------------------*/
 /** @defgroup MCFSimplex_MACROS Compile-time switches in MCFSimplex.h
-    There is only one macro in MCFSimplex, but it is very important!
+    These are the macros of MCFSimplex; QUADRATICCOST is very important!
     @{ */
 
 #define QUADRATICCOST 0
@@ -70,6 +70,18 @@ namespace MCFClass_di_unipi_it
    Thus, with QUADRATICCOST == 0 the solver cannot solve problems with
    quadratic costs, but it does solve problems with linear costs faster. */
 
+#define MCFSIMPLEX_PROFILE 0
+
+/**< If MCFSIMPLEX_PROFILE > 0, then statistic information about the phases
+   of the Primal and Dual Simplex is collected during SolveMCF(), and can be
+   read with MCFGetProf() [see MCFProfile]: the number of calls to pricing,
+   ratio test, UpdateT() and potential update, the number of (degenerate)
+   pivots and the size of the subtrees moved by CutAndUpdateSubtree(). If
+   MCFSIMPLEX_PROFILE > 1, the (wallclock) time spent in each phase is also
+   measured; this requires two readings of the clock per phase per
+   iteration, which may noticeably slow down the code on small instances.
+   With MCFSIMPLEX_PROFILE == 0 nothing is collected, and nothing is paid. */
+
 /**@}  end( group( MCFCLASS_MACROS ) ) */
 /*--------------------------------------------------------------------------*/
 /*---------------------------- CLASSES -------------------------------------*/
@@ -126,6 +138,41 @@ class MCFSimplex: public MCFClass
   kCandidateListPivot  ///< Candidate List Pivot Rule
   };
 
+#if( MCFSIMPLEX_PROFILE )
+/** Statistics about the phases of the Primal and Dual Simplex during the
+    latest call to SolveMCF() [see MCFGetProf()]. For the Primal Simplex
+    pricing is the choice of the entering arc and the ratio test is the
+    computation of theta and of the leaving arc, plus the flow update along
+    the cycle; for the Dual Simplex pricing is the choice of the leaving
+    arc and the ratio test is the search of the entering arc in the cut
+    between T1 and T2, plus the flow update. A pivot is degenerate if the
+    primal (Primal Simplex) or dual (Dual Simplex) solution does not change.
+    Times, in seconds, are only measured if MCFSIMPLEX_PROFILE > 1. */
+
+ struct MCFProfile {
+  unsigned long NPrc;  ///< number of calls to the pricing rule
+  unsigned long NRto;  ///< number of ratio tests
+  unsigned long NUpd;  ///< number of calls to UpdateT()
+  unsigned long NPot;  ///< number of updates of the potentials
+  unsigned long NPiv;  ///< number of pivots
+  unsigned long NDgn;  ///< number of degenerate pivots
+  unsigned long NCut;  ///< number of calls to CutAndUpdateSubtree()
+  unsigned long NMvd;  ///< total number of nodes moved by them
+
+  double TPrc;         ///< time spent in pricing
+  double TRto;         ///< time spent in the ratio test
+  double TUpd;         ///< time spent in UpdateT()
+  double TPot;         ///< time spent updating the potentials
+
+  /// average number of nodes in the subtrees moved by UpdateT()
+  double AvgSubtree( void ) const {
+   return( NCut ? double( NMvd ) / double( NCut ) : 0 );
+   }
+  };
+#endif
+
+/*--------------------------------------------------------------------------*/
+
  struct MCFStatePtr {
   int	  *enterArcs;
   FNumber *flowEnterArcs;
@@ -254,6 +301,57 @@ class MCFSimplex: public MCFClass
 
  FONumber MCFGetFO( void ) const override;
 
+/*--------------------------------------------------------------------------*/
+ /// number of iterations (pivots) of the latest call to SolveMCF()
+
+ long MCFiter( void ) const { return( long( iterator ) ); }
+
+/*--------------------------------------------------------------------------*/
+
+#if( MCFSIMPLEX_PROFILE )
+ /// statistics about the latest call to SolveMCF() [see MCFProfile]
+
+ const MCFProfile & MCFGetProf( void ) const { return( Prof ); }
+#endif
+
+/*--------------------------------------------------------------------------*/
+/*------------------ METHODS FOR SAVING/RESTORING THE STATE ----------------*/
+/*--------------------------------------------------------------------------*/
+/** Same meaning as MCFClass::MCFGetWarmStart(). If a basis is available (i.e.,
+   the problem has been solved, even if not to optimality) WS->Tree is also
+   provided, with the arcs entering each node in the current spanning tree;
+   nodes entered by an artificial arc of the dummy root are roots. */
+
+ MCFWarmStart *MCFGetWarmStart( void ) const override;
+
+/*--------------------------------------------------------------------------*/
+/** Same meaning as MCFClass::MCFPutWarmStart(). Rather than the artificial
+   basis of CreateInitialPrimalBase(), the Primal Simplex is started from a
+   spanning tree built around the flows WS.X: the arcs with flow strictly
+   between the bounds are made basic (possibly after having cancelled the
+   cycles they form, which never increases the cost), and the tree is
+   completed with arcs having zero reduced cost w.r.t. potentials obtained
+   by a shortest path computation on the residual graph from WS.Pi (if any),
+   preferring those in WS.Tree (if any). If WS.X and WS.Pi are optimal the
+   tree is then an optimal basis, so that the Primal Simplex terminates
+   without pivots, and the basis can be used e.g. for sensitivity analysis.
+   If the flows are not feasible for the current data, the tree is anyway
+   made primal feasible with artificial arcs, as in the reoptimization after
+   ChgDfcts().
+
+   The spanning tree replaces any previously found solution, and
+   MCFGetStatus() becomes kStopped until the next call to SolveMCF(). This
+   is only implemented for the (linear) Primal Simplex: if the Dual Simplex
+   is used, or QUADRATICCOST == 1, the method does nothing. */
+
+ void MCFPutWarmStart( const MCFWarmStart &WS ) override;
+
+/*--------------------------------------------------------------------------*/
+/** Same meaning as MCFClass::MCFGetMemory(). The candidate list of the
+   kCandidateListPivot pricing rule is counted in Extra. */
+
+ MCFMemory MCFGetMemory( void ) const override;
+
 /*--------------------------------------------------------------------------*/
 /*-------------- METHODS FOR READING THE DATA OF THE PROBLEM ---------------*/
 /*--------------------------------------------------------------------------*/
@@ -627,6 +725,10 @@ class MCFSimplex: public MCFClass
                                 // start their search from this arc
 
  iteratorType iterator;         // the current number of iterations
+
+ #if( MCFSIMPLEX_PROFILE )
+  MCFProfile Prof;              // statistics of the latest SolveMCF()
+ #endif
     
  primalCandidType *candP;       // every element points to an element of the
                                 // arcs vector which contains an arc violating 
@@ -714,6 +816,33 @@ class MCFSimplex: public MCFClass
    the sink nodes. The dummy root balance is 0, the costs of dummy arcs are
    fixed to "infinity". */
 
+/*--------------------------------------------------------------------------*/
+
+  void CreateWarmPrimalBase( cFRow X , cCRow Pi , cIndex_Set Tree );
+
+/**< Method to create an initial primal base from the given flows X[], and
+   possibly potentials Pi[] and spanning forest Tree[], for
+   MCFPutWarmStart(). */
+
+/*--------------------------------------------------------------------------*/
+
+  void Adjacency( Index_Set Fst , arcPType **Adj , bool basic , bool dummy );
+
+/**< Method to build the adjacency lists (in both directions) of the basic
+   real arcs if basic == true, of all the open ones otherwise, plus the basic
+   dummy arcs if dummy == true: the arcs incident to the node nodesP + i are
+   Adj[ Fst[ i ] ] ... Adj[ Fst[ i + 1 ] - 1 ]. */
+
+/*--------------------------------------------------------------------------*/
+
+  arcPType *CancelCycle( arcPType *arc , arcPType **Cyc , bool *Ori );
+
+/**< Method to send flow along the cycle formed by the basic arc "arc" with
+   the forest described by the enteringTArc and subTreeLevel fields of the
+   nodes, until some arc reaches one of its bounds; the direction is chosen
+   in such a way that the cost does not increase. That arc is made non-basic
+   and returned. Cyc[] and Ori[] are temporaries of size n. */
+
 /*--------------------------------------------------------------------------*/
 
   void CreateInitialDualBase( void );
@@ -989,6 +1118,17 @@ class MCFSimplex: public MCFClass
 /**< Method to calculate the temporary (or the final) objective function
    value. */
 
+/*--------------------------------------------------------------------------*/
+
+  void GetProgress( MCFProgress &P ) const;
+
+/**< Method to fill the MCFProgress passed to the callback [see
+   SetMCFCallback()]: FO is GetFO(), hence it includes the cost of the flow
+   on the artificial arcs; PInf is the total flow on the artificial arcs for
+   the Primal Simplex and the total violation of the bounds for the Dual
+   Simplex; DInf is the total violation of the reduced costs for the
+   (linear) Primal Simplex, and 0 for the Dual Simplex. */
+
 /*--------------------------------------------------------------------------*/
     
   void PrintPNode( nodePType *nodo );
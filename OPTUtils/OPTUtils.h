@@ -62,10 +62,25 @@
     - 7 = Use the ANSI C routine time() of time.h; note that this returns
           wallclock time rather than CPU time       
 
+    - 8 = Measure at the same time the wallclock time, with the monotonic
+          std::chrono::steady_clock, and the CPU time of both the calling
+          thread and the whole process, with the POSIX clock_gettime();
+          which one is returned by Read() is chosen at run time with
+          SetClock(), the default being the CPU time of the process. The
+          resolution is that of the clocks (typically nanoseconds), and
+          unlike clock() the CPU time of a single thread is not affected by
+          other threads running at the same time. This requires POSIX, hence
+          it is only the default on Unix-like platforms; elsewhere (e.g.,
+          WIN32) the default is 5.
+
     Any unsupported value would simply make the class to report constant
     zero as the time. */
 
-#define OPT_TIMERS 5
+#if defined( __unix__ ) || defined( __APPLE__ )
+ #define OPT_TIMERS 8
+#else
+ #define OPT_TIMERS 5
+#endif
 
 /*---------------------------- OPT_RANDOM ---------------------------------*/
 /** The class OPTrand is defined below to give an abstract interface to the
@@ -110,6 +125,9 @@
  #include <time.h>
 #elif( OPT_TIMERS == 6 )
  #include <sys/time.h>
+#elif( OPT_TIMERS == 8 )
+ #include <chrono>
+ #include <time.h>
 #endif
 
 /*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -*/
@@ -145,8 +163,29 @@ class OPTtimers {
 
  public:  //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  /// the clocks that can be read if OPT_TIMERS == 8 [see SetClock()]
+  enum OPTclock { kWall = 0 ,   ///< wallclock time
+                  kThrdCPU ,    ///< CPU time of the calling thread
+                  kProcCPU      ///< CPU time of the whole process
+                  };
+
   /// constructor of the class
-  OPTtimers( void ) { ReSet(); }
+  OPTtimers( void ) { clk = kProcCPU; ReSet(); }
+
+  /** Selects the clock read by Read( void ) and Read( tu , ts ), among
+      those of OPTclock; it has no effect unless OPT_TIMERS == 8, as
+      otherwise there is only one clock. Note that the CPU time of the
+      thread is only meaningful if Start() and Read() / Stop() are called
+      by the same thread. Values outside OPTclock are ignored. Reading
+      either CPU clock costs a system call, while kWall typically does not,
+      hence kWall is the cheapest choice for frequent Read(). */
+  void SetClock( int c ) {
+   if( ( c >= kWall ) && ( c <= kProcCPU ) )
+    clk = c;
+   }
+
+  /// returns the clock read by Read() [see SetClock()]
+  int GetClock( void ) const { return( clk ); }
 
   /// start the timer
   void Start( void ) {
@@ -165,6 +204,9 @@ class OPTtimers {
      t_u = double( t.tv_sec + t.tv_usec * 1e-6 );
     #elif( OPT_TIMERS == 7 )
      time( &tu );
+    #elif( OPT_TIMERS == 8 )
+     for( int c = kWall ; c <= kProcCPU ; c++ )
+      t_0[ c ] = Now( c );
     #endif
 
     ticking = true;
@@ -173,7 +215,14 @@ class OPTtimers {
 
   /// stop the timer
   void Stop( void ) {
-   if( ticking ) { Read( u , s ); ticking = false; }
+   if( ticking ) {
+    #if( OPT_TIMERS == 8 )
+     Read( acc[ kWall ] , acc[ kThrdCPU ] , acc[ kProcCPU ] );
+    #else
+     Read( u , s );
+    #endif
+    ticking = false;
+    }
    }
 
   /** Return the elapsed time. If the clock is ticking, return the *total*
@@ -205,19 +254,64 @@ class OPTtimers {
      tu += double( t.tv_sec + t.tv_usec * 1e-6 ) - t_u;
     #elif( OPT_TIMERS == 7 )
      tu += difftime( time( NULL ) , t_u );
+    #elif( OPT_TIMERS == 8 )
+     tu += Now( clk ) - t_0[ clk ];  // only the selected clock is read
+    #endif
+    }
+   else {
+    #if( OPT_TIMERS == 8 )
+     tu += acc[ clk ];
+     (void) ts;  // there is no separate system time to add
+    #else
+     tu += u;
+     ts += s;
     #endif
     }
-   else { tu += u; ts += s; }
+   }
+
+  /** *Adds* to tw, tt and tp the wallclock time, the CPU time of the
+      thread, and the CPU time of the process, respectively. If OPT_TIMERS
+      != 8 only one of them is available: it is added to tw if it is a
+      wallclock time and to tp otherwise. */
+  void Read( double &tw , double &tt , double &tp ) {
+   #if( OPT_TIMERS == 8 )
+    if( ticking ) {
+     tw += Now( kWall ) - t_0[ kWall ];
+     tt += Now( kThrdCPU ) - t_0[ kThrdCPU ];
+     tp += Now( kProcCPU ) - t_0[ kProcCPU ];
+     }
+    else {
+     tw += acc[ kWall ];
+     tt += acc[ kThrdCPU ];
+     tp += acc[ kProcCPU ];
+     }
+   #else
+    double tu = 0;
+    double ts = 0;
+    Read( tu , ts );
+    #if( ( OPT_TIMERS == 1 ) || ( OPT_TIMERS == 2 ) || ( OPT_TIMERS == 5 ) )
+     tp += tu + ts;
+    #else
+     tw += tu + ts;
+    #endif
+   #endif
    }
 
   /// reset the timer
-  void ReSet( void ) { u = s = 0; ticking = false; }
+  void ReSet( void ) {
+   u = s = 0;
+   #if( OPT_TIMERS == 8 )
+    acc[ kWall ] = acc[ kThrdCPU ] = acc[ kProcCPU ] = 0;
+   #endif
+   ticking = false;
+   }
 
  private:  //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
  double u;      // elapsed *user* time, in seconds
  double s;      // elapsed *system* time, in seconds
  bool ticking;  // if the clock is ticking
+ int clk;       // the clock read by Read() (only used if OPT_TIMERS == 8)
 
  #if( ( OPT_TIMERS > 0 ) && ( OPT_TIMERS <= 5 ) )
   clock_t t_u;
@@ -233,6 +327,21 @@ class OPTtimers {
   double t_u;
  #elif( OPT_TIMERS == 7 )
   time_t t_u;
+ #elif( OPT_TIMERS == 8 )
+  double t_0[ 3 ];  // the value of each clock at the latest Start()
+  double acc[ 3 ];  // the elapsed time of each clock, in seconds
+
+  // the current value of clock c, in seconds from some fixed point
+  static double Now( int c ) {
+   if( c == kWall )
+    return( std::chrono::duration< double >(
+	     std::chrono::steady_clock::now().time_since_epoch() ).count() );
+
+   struct timespec t;
+   clock_gettime( c == kThrdCPU ? CLOCK_THREAD_CPUTIME_ID
+		                : CLOCK_PROCESS_CPUTIME_ID , &t );
+   return( double( t.tv_sec ) + double( t.tv_nsec ) * 1e-9 );
+   }
  #endif
 
  };  // end( class OPTtimers );
@@ -133,6 +133,19 @@
 
    By setting AUCTION == 0, some memory is saved. */
 
+/*---------------------------- RELAXIV_PAUCTION ----------------------------*/
+
+#define RELAXIV_PAUCTION 0
+
+/**< Decides if the parallel version of the auction initialization is
+   compiled. If RELAXIV_PAUCTION > 0, the starting solution can be generated
+   by a parallel "Jacobi" version of the auction initialization run by any
+   number of threads [see kAuctionThreads in SetPar() below]. This is
+   *experimental*: its scaling with the number of threads has never been
+   measured, and on a single core it makes SolveMCF() slower than the
+   default initialization for any number of threads. Hence it is off by
+   default, in which case kAuctionThreads can only be 0. */
+
 /*-------------------------- RELAXIV_STATISTICS ----------------------------*/
 
 #define RELAXIV_STATISTICS 0
@@ -140,6 +153,23 @@
 /**< If RELAXIV_STATISTICS > 0, then statistic information about the behaviour
    of the Relaxation algorithm is computed. */
 
+/*---------------------------- RELAXIV_COMPACT -----------------------------*/
+
+#define RELAXIV_COMPACT 0
+
+/**< Decides if the working arrays are laid out so as to minimize memory.
+   If RELAXIV_COMPACT > 0, the boolean vectors used in the multinode
+   iterations are packed into bitsets, and the temporaries of the
+   initialization phase share their memory with these of the main loop,
+   since the two never run at the same time: the directional derivatives
+   used in the standard initialization live in the same memory as the
+   labels and predecessors of the multinode iterations and, if AUCTION > 0,
+   the temporaries of the auction initialization live in the memory of the
+   lists of balanced arcs (which are rebuilt after it) and of the
+   directional derivatives. This saves 9.75 bytes per node, plus 16 bytes
+   per node and 8 bytes per arc if AUCTION > 0, for a (usually negligible)
+   cost in the bit operations. */
+
 /** @} ---------------------------------------------------------------------*/
 /*--------------------------- NAMESPACE ------------------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -169,7 +199,16 @@ class RelaxIV : public MCFClass {
     "extended" from MCFClass::MCFParam, to be used with the methods
     SetPar() and GetPar(). */
 
-  enum MCFRParam { kAuction = kLastParam     ///< crash initialization
+  enum MCFRParam { kAuction = kLastParam ,   ///< crash initialization
+                   kEpsGap ,                  ///< early termination gap
+                   kAuctionThreads            ///< parallel init (experimental)
+                   };
+
+/*--------------------------------------------------------------------------*/
+/** Public enum describing the further possible return values of
+    MCFGetStatus(), "extended" from MCFClass::MCFStatus. */
+
+  enum RIVStatus { kEpsOptimal = kError + 1  ///< gap-optimal solution found
                    };
 
 /*--------------------------------------------------------------------------*/
@@ -227,35 +266,88 @@ class RelaxIV : public MCFClass {
                used in SolveMCF() to generate the starting solution; if
 	       set to kNo (default), then the default initialization based on
 	       special single-node relaxation iterations is used instead.
-	       Note that this parameter is *ignored* if AUCTION == 0. */
+	       Note that this parameter is *ignored* if AUCTION == 0.
+
+   - kAuctionThreads: if set to a value k > 0 (default 0), the starting
+               solution of SolveMCF() is generated by a parallel "Jacobi"
+	       version of the auction initialization run by k threads [see
+	       pauction() below], which takes precedence over kAuction. All
+	       the nodes with positive surplus push flow along their
+	       admissible arcs at the same time, and then all these that
+	       still have some surplus left raise their prices at the same
+	       time, so that the k threads only synchronize three times per
+	       round.
+	       Since the result is an approximately optimal pseudoflow of the
+	       same kind as that of auction(), the relaxation method that
+	       follows is unchanged. This is available whatever the value of
+	       AUCTION, and it is ignored if the prices have been provided
+	       by MCFPutPi(). Note that this parameter can only be 0 (any
+	       other value throws) if RELAXIV_PAUCTION == 0, which is the
+	       default since this option is still experimental. */
 
    void SetPar( int par , int val ) override
    {
     if( par == kAuction ) {
      #if( AUCTION )
-      crash = ( val == kYes ) ? TRUE : FALSE;
+      crash = ( val == kYes );
      #else
       if( val == kYes )
        throw( MCFException( "Auction initialization not available" ) );
      #endif
      }
+    else
+     if( par == kAuctionThreads ) {
+      if( val < 0 )
+       throw( MCFException( "RelaxIV::SetPar: kAuctionThreads must be >= 0"
+			    ) );
+      #if( RELAXIV_PAUCTION )
+       AuctThrds = Index( val );
+      #else
+       if( val > 0 )
+	throw( MCFException(
+		      "Parallel auction initialization not available" ) );
+      #endif
+      }
     else
      MCFClass::SetPar( par , val );
   }
 
 /*--------------------------------------------------------------------------*/
-// set double parameters of the algorithm
-/* Set double parameters of the algorithm.
- *
- * This should in princible not be necessary, as RelaxIV has no double
- * parameters to set. However, without this being well-defined, template
- * classes having RelaxIV as template type may fail to be able to use the
- * base class method in its stead and resort to wrongly calling the
- * SetPar( , int ) version instead (no idea why), so this useless method has
- * to be kept here. */
+/// set double parameters of the algorithm
+/** Set double parameters of the algorithm.
+
+   @param par   is the parameter to be set;
+
+   @param val   is the value to assign to the parameter.
+
+   Apart from the parameters of the base class, this method handles:
+
+   - kEpsGap: if set to a value > 0 (default 0), SolveMCF() periodically
+              turns the current pseudoflow into a feasible flow by routing
+	      the residual deficits along augmenting paths, which gives an
+	      upper bound on the optimal value, and compares it with the
+	      lower bound given by the current potentials. As soon as the
+	      relative gap ( UB - LB ) / max( |UB| , 1 ) is <= val, SolveMCF()
+	      stops with status kEpsOptimal [see RIVStatus above] and the
+	      feasible flow as primal solution; the gap actually attained can
+	      then be read with MCFGetGap() [see below]. The check costs
+	      O( m ) for each augmenting path, and it is performed at most
+	      once per pass over the queue of unbalanced nodes.
+
+   Note that, without this being well-defined, template classes having
+   RelaxIV as template type may fail to be able to use the base class method
+   in its stead and resort to wrongly calling the SetPar( , int ) version
+   instead (no idea why), so this method has to be kept here anyway. */
 
    void SetPar( int par , double val ) override {
-    MCFClass::SetPar( par , val );
+    if( par == kEpsGap ) {
+     if( val < 0 )
+      throw( MCFException( "RelaxIV::SetPar: kEpsGap must be >= 0" ) );
+
+     EpsGap = val;
+     }
+    else
+     MCFClass::SetPar( par , val );
     }
 
 /*--------------------------------------------------------------------------*/
@@ -265,8 +357,8 @@ class RelaxIV : public MCFClass {
 
    @param val  upon return, it will contain the value of the parameter.
 
-   Apart from the parameters of the base class, this method handles kAuction.
-   */
+   Apart from the parameters of the base class, this method handles kAuction
+   and kAuctionThreads. */
 
    void GetPar( int par , int &val ) const override {
     if( par == kAuction )
@@ -275,21 +367,33 @@ class RelaxIV : public MCFClass {
      #else
       val = kNo;
      #endif
+    else
+     if( par == kAuctionThreads )
+      #if( RELAXIV_PAUCTION )
+       val = int( AuctThrds );
+      #else
+       val = 0;
+      #endif
     else
      MCFClass::GetPar( par , val );
     }
 
 /*--------------------------------------------------------------------------*/
-/** Returns one of the double parameters of the algorithm
- *
- * This should in princible not be necessary, as RelaxIV has no double
- * parameters to report. However, without this being well-defined, template
- * classes having RelaxIV as template type may fail to be able to use the
- * base class method in its stead (no idea why), so this useless method has
- * to be kept here. */
+/** Returns one of the double parameters of the algorithm.
+
+   @param par  is the parameter to return [see SetPar( double ) for
+               comments];
+
+   @param val  upon return, it will contain the value of the parameter.
+
+   Apart from the parameters of the base class, this method handles kEpsGap.
+   */
 
  void GetPar( int par , double &val ) const override {
-  MCFClass::GetPar( par , val );
+  if( par == kEpsGap )
+   val = EpsGap;
+  else
+   MCFClass::GetPar( par , val );
   }
 
 /*--------------------------------------------------------------------------*/
@@ -348,6 +452,20 @@ class RelaxIV : public MCFClass {
 
    FONumber MCFGetFO( void ) const override { return( FO ); }
 
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   FONumber MCFGetDFO( void ) const override {
+    if( status == kEpsOptimal )
+     return( DFO );
+
+    return( MCFClass::MCFGetDFO() );
+    }
+
+/**< Same meaning as MCFClass::MCFGetDFO(). If MCFGetStatus() == kEpsOptimal,
+   this is the lower bound given by the potentials returned by MCFGetPi(),
+   which differs from MCFGetFO() by no more than the relative gap returned
+   by MCFGetGap() [see below]. */
+
 /*--------------------------------------------------------------------------*/
 
    MCFStatePtr MCFGetState( void ) const override;
@@ -361,6 +479,24 @@ class RelaxIV : public MCFClass {
 
    void MCFPutState( MCFClass::MCFStatePtr S ) override;
 
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void MCFPutWarmStart( const MCFWarmStart &WS ) override;
+
+/**< Same meaning as MCFClass::MCFPutWarmStart(). Being a dual algorithm,
+   RelaxIV only uses the node potentials WS.Pi (if any), exactly as if they
+   were passed to MCFPutPi() [see below]; the flows and the tree are
+   ignored. */
+
+/*--------------------------------------------------------------------------*/
+
+   MCFMemory MCFGetMemory( void ) const override;
+
+/**< Same meaning as MCFClass::MCFGetMemory(). The temporaries of the auction
+   initialization (if AUCTION > 0) and the workspace of the gap check [see
+   kEpsGap in SetPar()], which is only allocated the first time it is
+   performed, are counted in Extra. */
+
 /*--------------------------------------------------------------------------*/
 /*-------------- METHODS FOR READING THE DATA OF THE PROBLEM ---------------*/
 /*--------------------------------------------------------------------------*/
@@ -557,6 +693,28 @@ class RelaxIV : public MCFClass {
 /*--------------------------------------------------------------------------*/
 /*------------------------ SPECIALIZED INTERFACE ---------------------------*/
 /*--------------------------------------------------------------------------*/
+   /// give a starting vector of node potentials
+
+   void MCFPutPi( cCRow P );
+
+/**< Provides a vector of node potentials from which the next call to
+   SolveMCF() starts, e.g. the optimal potentials of a "similar" instance as
+   returned by MCFGetPi() by RelaxIV itself or by any other MCF solver. P[]
+   must contain MCFn() potentials; passing P == 0 removes any previously set
+   vector, so that the default starting point (all-0 potentials) is used.
+
+   The initialization in SolveMCF() then computes the reduced costs
+   RC[ i , j ] = C[ i , j ] + P[ i ] - P[ j ], sets the flows so as to
+   satisfy complementary slackness with them, and improves the potentials
+   with the usual passes of single-node relaxation iterations (even if
+   kAuction is set) before the relaxation method starts: the closer P[] is
+   to an optimal vector, the fewer iterations this requires. Since this
+   replaces any previously found solution, MCFGetStatus() becomes kUnSolved.
+   Changes to the data of the problem are allowed between MCFPutPi() and
+   SolveMCF(), as the potentials are only used by the latter; however, P[]
+   is only used by the first call to SolveMCF() after MCFPutPi(). */
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -*/
    /// total number of (single-node or multinode) iterations
 
    int MCFiter( void ) const { return( iter ); }
@@ -566,6 +724,17 @@ class RelaxIV : public MCFClass {
 
    int MCFaug( void ) const { return( num_augm ); }
 
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -*/
+   /// relative primal-dual gap attained by the last SolveMCF()
+
+   double MCFGetGap( void ) const { return( Gap ); }
+
+/**< Returns the relative gap ( MCFGetFO() - MCFGetDFO() ) /
+   max( |MCFGetFO()| , 1 ) attained by the last call to SolveMCF(); this is
+   0 if MCFGetStatus() == kOK, and it is <= the value of the parameter
+   kEpsGap [see SetPar( double )] if MCFGetStatus() == kEpsOptimal. In all
+   other cases Inf< double >() is returned. */
+
 /*--------------------------------------------------------------------------*/
 
 #if( RELAXIV_STATISTICS )
@@ -617,6 +786,56 @@ class RelaxIV : public MCFClass {
   typedef const SIndex    cSIndex;           ///< a read-only SIndex
   typedef cSIndex        *cSIndex_Set;       ///< read-only SIndex array
 
+/*--------------------------------------------------------------------------*/
+
+#if( RELAXIV_COMPACT )
+   /** Bit-packed vector of booleans, accessed with the same [] syntax as a
+       Bool_Vec; the (1-based) bits live in the words pointed by v, which is
+       allocated and deallocated by RelaxIV itself. */
+
+   class Bit_Vec {
+    public:
+     typedef unsigned long Word;    ///< a chunk of bits
+
+     static constexpr Index WBits = 8 * sizeof( Word );
+
+     class Ref {  ///< reference to a single bit
+      public:
+       Ref( Word &w , Word msk ) : wrd( w ) , mask( msk ) {}
+
+       operator bool( void ) const { return( wrd & mask ); }
+
+       bool operator=( bool b ) {
+	if( b )
+	 wrd |= mask;
+	else
+	 wrd &= ~mask;
+	return( b );
+        }
+
+      private:
+       Word &wrd;
+       Word mask;
+       };
+
+     Ref operator[]( Index i ) {
+      return( Ref( v[ i / WBits ] , Word( 1 ) << ( i % WBits ) ) );
+      }
+
+     bool operator[]( Index i ) const {
+      return( v[ i / WBits ] & ( Word( 1 ) << ( i % WBits ) ) );
+      }
+
+     static Index Words( Index n ) { return( n / WBits + 1 ); }
+
+     Word *v;
+     };
+
+   typedef Bit_Vec        Flag_Vec;         ///< vector of flags
+#else
+   typedef Bool_Vec       Flag_Vec;         ///< vector of flags
+#endif
+
 /*--------------------------------------------------------------------------*/
 
    class RIVState : public MCFClass::MCFState {
@@ -673,6 +892,16 @@ class RelaxIV : public MCFClass {
    void auction( void );
  #endif
 
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -*/
+
+ #if( RELAXIV_PAUCTION )
+   struct PAState;  ///< shared state of the threads of pauction()
+
+   bool pauction( void );
+
+   void pauct_round( PAState &S , Index th );
+ #endif
+
 /*--------------------------------------------------------------------------*/
 /*----------------------- called in init_standard --------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -721,7 +950,11 @@ class RelaxIV : public MCFClass {
 
 /*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -*/
 
-   void cmptprices( void );
+   void cmptprices( Index_Set stck );
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -*/
+
+   double cmptgap( void );
 
 /*--------------------------------------------------------------------------*/
 
@@ -744,6 +977,10 @@ class RelaxIV : public MCFClass {
  FRow Dfct;               ///< node residual deficits
 
  FONumber FO;             ///< Objective Function value
+ FONumber DFO;            ///< lower bound when status == kEpsOptimal
+
+ double EpsGap;           ///< relative gap for early termination (0 = off)
+ double Gap;              ///< relative gap attained by last SolveMCF()
 
  Index_Set tfstou;        ///< first forward balanced arc
  Index_Set tnxtou;        ///< next forward balanced arc
@@ -769,6 +1006,10 @@ class RelaxIV : public MCFClass {
 			   * single node relaxation iterations */
  #endif
 
+ #if( RELAXIV_PAUCTION )
+  Index AuctThrds;        ///< number of threads of pauction(), 0 = not used
+ #endif
+
  int iter;                ///< number of iterations (of both types)
  int num_augm;            ///< number of flow augmentation steps
  #if( RELAXIV_STATISTICS )
@@ -804,20 +1045,28 @@ class RelaxIV : public MCFClass {
                      *     Auction() initialization. */
 
  CRow Pi;          ///< node Potentials
+ bool PiSeed;      ///< true if Pi[] has been set by MCFPutPi()
 
- Bool_Vec mark;      ///< temporary for multinode iterations
+ Flag_Vec mark;      ///< temporary for multinode iterations
  Index_Set save;     ///< temporary for multinode iterations
  Index_Set label;    ///< temporary for multinode iterations
  SIndex_Set Prdcsr;  ///< temporary for multinode iterations
 
- Bool_Vec scan;    ///< which node belongs to S in multinode iteration
+ Flag_Vec scan;    ///< which node belongs to S in multinode iteration
  Index_Set queue;  ///< queue of non zero deficit nodes
  Index lastq;      ///< index of the last element in the queue
  Index prvnde;     ///< index of the element preceding lastqueue
+ Index RsmNde;     ///< if status == kStopped, the node where it stopped,
+ Index RsmNDf;     ///< the number of nonzero deficit nodes at that time
+ Index RsmPss;     ///< and the number of passes done so far
 
  FRow DDNeg;       ///< positive directional derivative at nodes
  FRow DDPos;       ///< negative directional derivative at nodes
 
+ FRow GpD;          ///< repair flow in cmptgap(), allocated on demand
+ SIndex_Set GpPrd;  ///< predecessor arcs in cmptgap()
+ Index_Set GpQ;     ///< node deque in cmptgap()
+
  #if( AUCTION )
   CRow SB_level;          ///< temporary used in Auction()
   SIndex_Set extend_arc;  ///< temporary used in Auction()
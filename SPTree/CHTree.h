@@ -0,0 +1,316 @@
+/*--------------------------------------------------------------------------*/
+/*----------------------------- File CHTree.h ------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Definition of CHTree, a class implementing Contraction Hierarchies for
+ * answering very many Origin-Dest shortest path queries on a graph whose
+ * arc costs do not change. The graph is taken from any MCFClass (typically
+ * a SPTree) via MCFArcs() and MCFCosts(); the preprocessing can use
+ * several threads, and the resulting hierarchy can be saved to / loaded
+ * from a binary stream, so that it needs to be computed only once. Full
+ * origin x destination distance matrices are computed by the bucket-based
+ * many-to-many algorithm.
+ *
+ * \author Antonio Frangioni \n
+ *         Dipartimento di Informatica \n
+ *         Universita' di Pisa \n
+ *
+ * \copyright &copy; by Antonio Frangioni
+ */
+/*--------------------------------------------------------------------------*/
+/*----------------------------- DEFINITIONS --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#ifndef _CHTree
+ #define _CHTree  /* self-identification: #endif at the end of the file */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ INCLUDES ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#include "SPTree.h"
+
+#include <iostream>
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- MACROS --------------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @defgroup CHTREE_MACROS Compile-time switches in CHTree.h
+ *  These macros control some important details of the implementation.
+ *  @{ */
+
+/*------------------------------ CH_WTNS_MAX -------------------------------*/
+
+#define CH_WTNS_MAX 500
+
+/**< Maximum number of nodes settled by each "witness search" during the
+   preprocessing. When a node v is contracted, a shortcut u --> w is added
+   for each pair of neighbours unless a path from u to w not passing by v
+   and not longer than u --> v --> w is found by a (truncated) Dijkstra
+   search from u. Stopping the search earlier makes the preprocessing
+   faster, at the cost of some useless shortcuts (the hierarchy is correct
+   anyway). */
+
+/** @} ---------------------------------------------------------------------*/
+/*--------------------------- NAMESPACE ------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+namespace MCFClass_di_unipi_it
+{
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- CLASSES -------------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** The CHTree class implements Contraction Hierarchies: the nodes of the
+ *  graph are "contracted" one after the other, adding "shortcut" arcs that
+ *  preserve all the shortest path distances among the remaining ones, and
+ *  an Origin-Dest query is then answered by two Dijkstra searches (forward
+ *  from the Origin and backward from the Dest) that only move towards
+ *  nodes contracted later, and therefore visit a tiny part of the graph.
+ *
+ *  The preprocessing contracts, at each round, a set of nodes no two of
+ *  which are adjacent, chosen among these with the smallest "edge
+ *  difference" (number of shortcuts added minus number of arcs removed)
+ *  in their neighbourhood; the witness searches of the nodes in the set
+ *  are independent, and are run in parallel.
+ *
+ *  Shortest paths are returned as sequences of names of the arcs of the
+ *  original graph, the shortcuts being unpacked recursively.
+ *
+ *  \warning Arc costs must be nonnegative. */
+
+class CHTree
+{
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PUBLIC PART OF THE CLASS -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ public:
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- PUBLIC TYPES --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+  typedef MCFClass::Index      Index;
+  typedef MCFClass::cIndex     cIndex;
+  typedef MCFClass::Index_Set  Index_Set;
+  typedef MCFClass::cIndex_Set cIndex_Set;
+  typedef MCFClass::CNumber    CNumber;
+  typedef MCFClass::cCNumber   cCNumber;
+  typedef MCFClass::CRow       CRow;
+  typedef MCFClass::cCRow      cCRow;
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------- PUBLIC METHODS -------------------------------*/
+/*--------------------------------------------------------------------------*/
+/*---------------------------- CONSTRUCTOR ---------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   CHTree( void );
+
+/**< Constructor of the class: the hierarchy is empty until either Build()
+   or Load() is called. */
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- OTHER INITIALIZATIONS -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   void Build( const MCFClass &MCF , bool Drctd = true , Index NThr = 0 );
+
+/**< Computes the hierarchy for the graph of MCF, as given by MCFArcs() and
+   MCFCosts(); if Drctd == false each arc can be traversed in both
+   directions. Closed and deleted arcs, as well as these with
+   Inf< CNumber >() cost, are ignored; a negative arc cost throws
+   exception. The witness searches are distributed among NThr threads (0 =
+   as many as the hardware supports).
+
+   Any previous hierarchy is discarded. MCF is only read here, hence later
+   changes to it have no influence on the hierarchy: Build() has to be
+   called again if the costs change. */
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void Build( const SPTree &SPT , Index NThr = 0 ) {
+    Build( SPT , SPT.Directed() , NThr );
+    }
+
+///< as Build( const MCFClass & , ... ), with the directedness of SPT
+
+/*--------------------------------------------------------------------------*/
+
+   void Save( std::ostream &os ) const;
+
+/**< Writes the hierarchy on os in a (native-endian) binary format, that
+   can be read back by Load(); os must have been opened in binary mode. */
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+   void Load( std::istream &is );
+
+/**< Reads a hierarchy previously written by Save(), discarding the current
+   one; throws exception if the data is not in the right format. */
+
+/*--------------------------------------------------------------------------*/
+/*---------------------- METHODS FOR SOLVING THE PROBLEM -------------------*/
+/*--------------------------------------------------------------------------*/
+
+   CNumber Query( Index Org , Index Dst );
+
+/**< Returns the length of the shortest path from node Org to node Dst
+   (names as in MCFArcs(), that is depending on USENAME0), or
+   Inf< CNumber >() if there is no such path. The path itself can then be
+   obtained with Path().
+
+   The working memory of the searches is held in the object, hence
+   concurrent queries on the same CHTree are not allowed: each thread must
+   use its own copy of the hierarchy (e.g., obtained with Save() and
+   Load()). */
+
+/*--------------------------------------------------------------------------*/
+
+   void Matrix( Index NOrg , cIndex_Set Orgs , Index NDst , cIndex_Set Dsts ,
+		CRow Dist , Index NThr = 0 ) const;
+
+/**< Computes the distances from each of the NOrg nodes in Orgs[] to each
+   of the NDst nodes in Dsts[] (names as in Query()): upon return,
+   Dist[ k * NDst + h ] is the length of the shortest path from Orgs[ k ]
+   to Dsts[ h ], or Inf< CNumber >() if there is no such path.
+
+   The bucket-based many-to-many algorithm is used: a backward search from
+   each destination leaves in a "bucket" at each node it settles the
+   distance from that node to the destination, and then a forward search
+   from each origin combines its labels with the buckets of the nodes it
+   settles. Hence, only NOrg + NDst searches are made, rather than
+   NOrg * NDst queries. The searches are distributed among NThr threads
+   (0 = as many as the hardware supports), each one with its own working
+   memory; the object is not changed, hence this method can be called
+   concurrently with Query() and with itself. */
+
+/*--------------------------------------------------------------------------*/
+/*---------------------- METHODS FOR READING RESULTS -----------------------*/
+/*--------------------------------------------------------------------------*/
+
+   Index Path( Index_Set Arcs ) const;
+
+/**< Writes in Arcs[] the names of the original arcs (as in MCFArcs()) of
+   the shortest path found by the last Query(), in order from Org to Dst,
+   and returns their number; Arcs[] must be long enough to hold them (the
+   number of nodes minus one always is). If the last Query() found no
+   path, or Org == Dst, 0 is returned. */
+
+/*--------------------------------------------------------------------------*/
+/*-------------- METHODS FOR READING THE DATA OF THE PROBLEM ---------------*/
+/*--------------------------------------------------------------------------*/
+/// returns the number of nodes of the graph
+
+   Index NNodes( void ) const { return( n ); }
+
+/*--------------------------------------------------------------------------*/
+/// returns the number of arcs of the hierarchy, including the shortcuts
+
+   Index NEdges( void ) const { return( NE ); }
+
+/*--------------------------------------------------------------------------*/
+/** Returns the n-vector of the ranks of the nodes in the hierarchy, i.e.,
+   the position of each node (names from 0 to n - 1, irrespective of
+   USENAME0) in the contraction order. */
+
+   cIndex_Set Ranks( void ) const { return( Rnk ); }
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ DESTRUCTOR --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+   virtual ~CHTree();
+
+/*--------------------------------------------------------------------------*/
+/*--------------------- PRIVATE PART OF THE CLASS --------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ private:
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------- PRIVATE TYPES --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ struct CHBuild;    // the (temporary) data of the preprocessing
+
+ struct MtxJob;     // the (temporary) data of Matrix()
+
+ struct CHSrch {     // the working memory of a search:
+  CRow D;            // distance labels (Inf< CNumber >() = not reached),
+  Index_Set Pn;      // predecessor nodes and edges (if Pn != 0),
+  Index_Set Pr;
+  Index_Set T;       // the nT touched nodes (those with finite label),
+  Index nT;
+  Index_Set Hp;      // and the heap of size nH, with the position of each
+  Index_Set HPos;    // node in it
+  Index nH;
+  };
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- PRIVATE METHODS -------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ void Start( CHSrch &S , cIndex s ) const;
+
+ Index Settle( bool Bwd , CHSrch &S ) const;
+
+ void AllocS( CHSrch &S , bool Prd ) const;
+
+ void FreeS( CHSrch &S ) const;
+
+ void Unpack( Index e , Index_Set &Arcs ) const;
+
+ void MemAlloc( Index nUp , Index nDn );
+
+ void MemDeAlloc( void );
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PRIVATE DATA STRUCTURES  -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ Index n;            // number of nodes
+ Index NE;           // number of edges (arcs + shortcuts)
+
+ Index_Set Rnk;      // Rnk[ i ] = position of node i in the contraction
+                     // order (nodes are numbered from 0 here); in all the
+                     // other data structures nodes are named by their rank
+
+ Index_Set UpStrt;   // upward graph in forward star form: the edges from
+ Index_Set UpHd;     // i to nodes of larger rank are in positions
+ CRow      UpCst;    // UpStrt[ i ] ... UpStrt[ i + 1 ] - 1 of UpHd[]
+ Index_Set UpE;      // (heads), UpCst[] (costs) and UpE[] (edge names)
+
+ Index_Set DnStrt;   // downward graph in backward star form: the edges
+ Index_Set DnTl;     // to i from nodes of larger rank, with DnTl[] being
+ CRow      DnCst;    // the tails and the rest as for the upward graph
+ Index_Set DnE;
+
+ Index_Set ESub1;    // for each edge e: if ESub1[ e ] == Inf< Index >(),
+ Index_Set ESub2;    // e is the original arc named ESub2[ e ], otherwise
+                     // it is the shortcut of edges ESub1[ e ] and ESub2[ e ]
+
+ CHSrch SF;          // working memory of Query(): the forward (F) and
+ CHSrch SB;          // backward (B) searches
+
+ Index Mid;          // meeting node of the last Query() (Inf< Index >()
+                     // if no path has been found)
+
+/*--------------------------------------------------------------------------*/
+
+ };  // end( class CHTree )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+};  // end( namespace MCFClass_di_unipi_it )
+
+/*--------------------------------------------------------------------------*/
+
+#endif  /* CHTree.h included */
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- End File CHTree.h -----------------------------*/
+/*--------------------------------------------------------------------------*/
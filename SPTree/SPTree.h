@@ -6,7 +6,7 @@
  * conforming to the standard MCF interface defined therein, and implementing
  * several "classic" Shortest Path Tree algorithms to solve uncapacitated
  * single-source Min Cost Flow problems. The actual algorithm can be chosen
- * at compile time by setting a proper switch.
+ * at run time, while a proper switch sets the default one.
  *
  * \author Antonio Frangioni \n
  *         Dipartimento di Informatica \n
@@ -27,6 +27,9 @@
 
 #include "MCFClass.h"
 
+#include <cmath>
+#include <functional>
+
 /*--------------------------------------------------------------------------*/
 /*---------------------------- MACROS --------------------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -41,51 +44,71 @@
 
 #define SPT_ALGRTM 4
 
-/** This macro decides which SPT algorithm has to be used.
-   Possible values are:
+/** This macro decides which SPT algorithm is used by default, that is,
+   unless another one is chosen in the constructor or with SetPar() [see
+   SPTAlgrtm below]: all of them are always compiled in. Possible values
+   are:
 
    - 0  =>  LQueue
    - 1  =>  LDeque
    - 2  =>  (currently unused)
    - 3  =>  Dijkstra
    - 4  =>  Heap
+   - 5  =>  Bucket
+   - 6  =>  Delta
 
-   For algorithms based on priority lists, the macro LABEL_SETTING [see
-   below] can be set to 1 to say that the algorithm is of the
+   The algorithms based on priority lists (Dijkstra, Heap and Bucket) are of
+   the
    "label-setting" (nodes only exit from Q once) rather than of the
-   "label-correcting" (nodes may exit from Q more than once) type. */
+   "label-correcting" (nodes may exit from Q more than once) type; the
+   macro LABEL_SETTING [see below] tells which is the case for the default
+   algorithm. Delta (parallel delta-stepping) always computes the whole SPT,
+   and therefore it is treated as a label-correcting one. */
 
-#if( SPT_ALGRTM <= 2 )
+#if( ( SPT_ALGRTM <= 2 ) || ( SPT_ALGRTM == 6 ) )
  #define LABEL_SETTING 0
- ///< this is a label-correcting SPT algorithm
+ ///< the default SPT algorithm is label-correcting
 #else
  #define LABEL_SETTING 1
 
- /**< This macro decides if the "label-setting" style is used.
+ /**< The default SPT algorithm is label-setting.
 
     With a priority lists, the SPT algorithm applied to SPT problems
     with *all nonnegative arc costs* has the "label-setting" property:
     nodes only exit from Q once, hence when a node exits from Q its
     label is permanently set.
 
-    If LABEL_SETTING > 0 the code will assume that this property holds
-    and implement some things accordingly; in particular, the algorithm
-    is terminated when the last destination is extracted from Q even
-    though Q is still nonempty.
+    A label-setting algorithm assumes that this property holds and
+    implements some things accordingly; in particular, the algorithm is
+    terminated when the last destination is extracted from Q even though
+    Q is still nonempty.
 
-    \warning Solving a SPT algorithm with negative arc costs with
-             LABEL_SETTING > 0 may produce a suboptimal solution. */
+    \warning Solving a SPT algorithm with negative arc costs with a
+             label-setting algorithm may produce a suboptimal solution. */
+#endif
 
- #if( SPT_ALGRTM == 4 )
-  #define HeapCard 2
+#define HeapCard 2
 
-  /**< Number of sons of each node in the heap.
-     SPT_ALGRTM == 4 means using a C-ary heap to hold the node set Q: each
-     HeapCard is the ariety of the heap, i.e. the max number of sons of a
-     node in the heap. Special treatment is deserved to the case
-     HeapCard == 2. */
- #endif
-#endif
+/**< Default number of sons of each node in the heap.
+   The Heap algorithm uses a C-ary heap to hold the node set Q: HeapCard is
+   the default ariety of the heap, i.e. the max number of sons of a node in
+   the heap, which can be changed with SetPar( kHeapCard , ... ). Special
+   versions of the heap are compiled for arities 2 and 4, any other
+   ariety >= 2 uses a generic version. */
+
+/*------------------------------ SPT_BKT_MAXC ------------------------------*/
+
+#define SPT_BKT_MAXC 65535
+
+/**< Largest arc cost for which the Bucket algorithm can be used.
+   The Bucket algorithm (Dial's algorithm) holds the node set Q in a circular
+   array of C + 1 "buckets", where C is the largest arc cost, and therefore
+   requires all the arc costs to be integer numbers in 0 ... C. This is
+   automatically checked whenever costs are changed (LoadNet(), ChgCosts(),
+   ChgCost(), AddArc()): if any arc cost is fractional, negative or larger
+   than SPT_BKT_MAXC, the Bucket algorithm silently falls back to the Heap
+   one. Large values of C cost O( C ) memory and time at each (cold) start,
+   and possibly lots of empty buckets being scanned. */
 
 /*------------------------------ ORDRD_NMS ---------------------------------*/
 
@@ -116,7 +139,12 @@
    - 0 => the topology of the graph cannot be changed;
 
    - 1 => all the methods that change the topology of the graph are
-          implemented. */
+          implemented.
+
+   The latter changes the layout of the Forward Star for every user of the
+   class; if DYNMC_MCF_SPT == 0 the topology can still be made dynamic at
+   run time, for a single object, with SetPar( kDynTopo , kYes ), while
+   all the other objects keep the dense layout. */
 
 /** @} ---------------------------------------------------------------------*/
 /*--------------------------- NAMESPACE ------------------------------------*/
@@ -151,6 +179,66 @@ class SPTree : public MCFClass
 
  public:
 
+/*--------------------------------------------------------------------------*/
+/*---------------------------- PUBLIC TYPES --------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** Public enum describing the possible parameters of the SPT solver,
+    "extended" from MCFClass::MCFParam, to be used with the methods
+    SetPar() and GetPar(). */
+
+  enum SPTParam { kSPTAlgrtm = kLastParam ,  ///< the SPT algorithm
+                  kHeapCard ,                ///< the ariety of the heap
+                  kBiDirect ,                ///< bidirectional search
+                  kIncrmntl ,                ///< incremental SPT repair
+                  kDeltaThr ,                ///< threads of Delta
+                  kDeltaSt ,                 ///< the step of Delta
+                  kDynTopo                   ///< dynamic topology
+                  };
+
+/*--------------------------------------------------------------------------*/
+/** Public enum describing the available SPT algorithms, i.e., the possible
+    values of the kSPTAlgrtm parameter; the values are the same as these of
+    the macro SPT_ALGRTM. Each algorithm is a different "policy" for the
+    set Q of the nodes to be scanned, with the main loop of the algorithm
+    being compiled separately for each of them, so that the choice has no
+    cost in the inner loop. LQueue and LDeque are label-correcting, and
+    therefore also work with negative arc costs, while Dijkstra, Heap and
+    Bucket are label-setting [see LABEL_SETTING]. Bucket only works with
+    small nonnegative integer costs, and uses Heap otherwise [see
+    SPT_BKT_MAXC].
+
+    Delta is different: it is the delta-stepping algorithm of Meyer and
+    Sanders, where the nodes in Q are grouped in buckets of width delta
+    [see kDeltaSt], and all the nodes in the first nonempty bucket are
+    scanned in parallel by kDeltaThr threads, which dynamically take chunks
+    of them as they become free. It always computes the whole SPT, as the
+    label-correcting algorithms, and it only works with nonnegative arc
+    costs, using LQueue otherwise. The distances are the same as these of
+    the other algorithms (up to the rounding of sums of non-integer costs),
+    and the predecessors form a Shortest Path Tree, that is the same as the
+    one of the other algorithms if the shortest paths are unique. Note that
+    it has only been tested on a single core: its scaling with the number
+    of threads has not been measured yet. */
+
+  enum SPTAlgrtm { kLQueue = 0 ,     ///< FIFO queue (Bellman-Ford)
+                   kLDeque = 1 ,     ///< D'Esopo-Pape deque
+                   kDijkstra = 3 ,   ///< Dijkstra with an unordered list
+                   kHeap = 4 ,       ///< Dijkstra with a C-ary heap
+                   kBucket = 5 ,     ///< Dial's buckets (integer costs)
+                   kDelta = 6        ///< parallel delta-stepping
+                   };
+
+/*--------------------------------------------------------------------------*/
+/** Type of the function called by SPTBatch() [see below] for each origin:
+    the first argument is the position k of the origin in the list, the
+    second is the (temporary) SPTree object holding the solution for that
+    origin, that can be queried with any of the const methods (MCFGetPi(),
+    MCFGetX(), Reached(), Predecessors(), ArcPredecessors(), ...) but must
+    not be modified. The function is called concurrently by several threads,
+    each one with a different SPTree object. */
+
+  typedef std::function< void( Index , const SPTree & ) > SPTBatchFunc;
+
 /*--------------------------------------------------------------------------*/
 /*--------------------------- PUBLIC METHODS -------------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -158,7 +246,8 @@ class SPTree : public MCFClass
 /*---------------------------- CONSTRUCTOR ---------------------------------*/
 /*--------------------------------------------------------------------------*/
 
-   SPTree( Index nmx = 0 , Index mmx = 0 , bool Drctd = true );
+   SPTree( Index nmx = 0 , Index mmx = 0 , bool Drctd = true ,
+	   int Algrtm = SPT_ALGRTM );
 
 /**< Constructor of the class.
 
@@ -168,7 +257,10 @@ class SPTree : public MCFClass
    understood as directed (default), i.e., if the i-th arc is
    Sn[ i ] --> En[ i ], or undirected, i.e., the i-th arc is
    Sn[ i ] <--> En[ i ]. Undirected graphs are internally implemented by
-   doubling each arc, but this is completely hidden by the interface. */
+   doubling each arc, but this is completely hidden by the interface.
+
+   The parameter `Algrtm' is the SPT algorithm to be used [see SPTAlgrtm
+   above], which can later be changed with SetPar( kSPTAlgrtm , ... ). */
 
 /*--------------------------------------------------------------------------*/
 /*-------------------------- OTHER INITIALIZATIONS -------------------------*/
@@ -181,7 +273,8 @@ class SPTree : public MCFClass
 /**< Inputs a new network, as in MCFClass::LoadNet().
 
    Arcs with pC[ i ] == Inf< CNumber >() do not "exist". If
-   DYNMC_MCF_SPT > 0, these arcs are "closed".
+   DYNMC_MCF_SPT > 0, or SetPar( kDynTopo , kYes ) has been called, these
+   arcs are "closed".
 
    If DYNMC_MCF_SPT == 0, these arcs are just removed from the formulation.
    However, they have some sort of a "special status" (after all, if the
@@ -190,6 +283,192 @@ class SPTree : public MCFClass
    will always have 0 flow and Inf< CNumber >() reduced cost as "closed" or
    "deleted" arcs. */
 
+/*--------------------------------------------------------------------------*/
+/// set integer parameters of the algorithm
+/** Set integer parameters of the algorithm.
+
+   @param par   is the parameter to be set;
+
+   @param val   is the value to assign to the parameter.
+
+   Apart from the parameters of the base class, this method handles:
+
+   - kSPTAlgrtm: the SPT algorithm to be used, one of the values of
+                 SPTAlgrtm [see above] (default SPT_ALGRTM); changing it
+		 discards the current solution;
+
+   - kHeapCard:  the ariety of the heap used by the Heap algorithm, that
+                 must be >= 2 (default HeapCard);
+
+   - kBiDirect:  if kYes, Origin-Dest shortest paths are computed by a
+                 bidirectional search [see ShortestPathTree()] (default
+		 kNo); not available if DYNMC_MCF_SPT > 0;
+
+   - kIncrmntl:  if kYes, once a complete Shortest Path Tree has been
+                 computed the changes of the arc costs are recorded, and
+		 the tree is repaired rather than recomputed from scratch
+		 [see ShortestPathTree()] (default kNo); not available if
+		 DYNMC_MCF_SPT > 0;
+
+   - kDeltaThr:  the number of threads used by the Delta algorithm, 0
+                 meaning std::thread::hardware_concurrency() (default 0);
+
+   - kDynTopo:   if kYes, the topology of the graph can be changed with
+                 CloseArc(), OpenArc(), DelArc(), AddArc() and ChangeArc()
+		 (default kNo). Each FS( i ) then has some free positions
+		 at its end, where the new arcs of i are put; when there is
+		 no room left, the whole Forward Star is rebuilt giving each
+		 node a number of free positions proportional to its arcs,
+		 which is also done when the free positions are too many.
+		 The free positions are scanned as arcs of infinite cost,
+		 hence each search costs a little more. Changing it
+		 rebuilds the Forward Star and discards the current
+		 solution; not available if DYNMC_MCF_SPT > 0. */
+
+   void SetPar( int par , int val ) override {
+    if( par == kSPTAlgrtm ) {
+     if( ( val < kLQueue ) || ( val > kDelta ) || ( val == 2 ) )
+      throw( MCFException( "SPTree::SetPar: unknown SPT algorithm" ) );
+
+     if( SPTAlg != val ) {
+      SPTAlg = val;
+      status = MCFClass::kUnSolved;
+      }
+     }
+    else
+     if( par == kHeapCard ) {
+      if( val < 2 )
+       throw( MCFException( "SPTree::SetPar: kHeapCard must be >= 2" ) );
+
+      if( HeapC != Index( val ) ) {
+       HeapC = Index( val );
+       if( SPTAlg == kHeap )
+	status = MCFClass::kUnSolved;
+       }
+      }
+    else
+     if( par == kBiDirect ) {
+      #if( DYNMC_MCF_SPT )
+       if( val == kYes )
+	throw( MCFException(
+		  "SPTree::SetPar: kBiDirect not available if DYNMC_MCF_SPT" ) );
+      #endif
+      BiDir = ( val == kYes );
+      }
+    else
+     if( par == kIncrmntl ) {
+      #if( DYNMC_MCF_SPT )
+       if( val == kYes )
+	throw( MCFException(
+		  "SPTree::SetPar: kIncrmntl not available if DYNMC_MCF_SPT" ) );
+      #endif
+      Incr = ( val == kYes );
+      if( ! Incr )
+       Full = false;
+      }
+    else
+     if( par == kDeltaThr ) {
+      if( val < 0 )
+       throw( MCFException( "SPTree::SetPar: kDeltaThr must be >= 0" ) );
+
+      DeltaThr = Index( val );
+      }
+    else
+     if( par == kDynTopo ) {
+      #if( DYNMC_MCF_SPT )
+       if( val == kYes )
+	throw( MCFException(
+		  "SPTree::SetPar: kDynTopo not available if DYNMC_MCF_SPT" ) );
+      #endif
+      if( DynT != ( val == kYes ) ) {
+       DynT = ( val == kYes );
+       if( nmax && mmax && n )
+	Relayout();
+       }
+      }
+    else
+     MCFClass::SetPar( par , val );
+    }
+
+/*--------------------------------------------------------------------------*/
+/// set float parameters of the algorithm
+/** Set float parameters of the algorithm.
+
+   @param par   is the parameter to be set;
+
+   @param val   is the value to assign to the parameter.
+
+   Apart from the parameters of the base class, this method handles:
+
+   - kDeltaSt:   the width delta of the buckets of the Delta algorithm, that
+                 must be >= 0 (default 0); 0 means that it is automatically
+		 chosen as the largest arc cost divided by the average
+		 out-degree of the nodes. Small values give more phases with
+		 little work each, large values more nodes scanned more than
+		 once; a delta smaller than the largest arc cost divided by
+		 the number of nodes is increased to that value. */
+
+   void SetPar( int par , double val ) override {
+    if( par == kDeltaSt ) {
+     if( val < 0 )
+      throw( MCFException( "SPTree::SetPar: kDeltaSt must be >= 0" ) );
+
+     Delta = CNumber( val );
+     }
+    else
+     MCFClass::SetPar( par , val );
+    }
+
+/*--------------------------------------------------------------------------*/
+/** Returns one of the integer parameters of the algorithm.
+
+   @param par  is the parameter to return [see SetPar( int ) for comments];
+
+   @param val  upon return, it will contain the value of the parameter.
+
+   Apart from the parameters of the base class, this method handles
+   kSPTAlgrtm, kHeapCard, kBiDirect, kIncrmntl, kDeltaThr and kDynTopo. */
+
+   void GetPar( int par , int &val ) const override {
+    if( par == kSPTAlgrtm )
+     val = SPTAlg;
+    else
+     if( par == kHeapCard )
+      val = int( HeapC );
+    else
+     if( par == kBiDirect )
+      val = BiDir ? kYes : kNo;
+    else
+     if( par == kIncrmntl )
+      val = Incr ? kYes : kNo;
+    else
+     if( par == kDeltaThr )
+      val = int( DeltaThr );
+    else
+     if( par == kDynTopo )
+      val = DynT ? kYes : kNo;
+    else
+     MCFClass::GetPar( par , val );
+    }
+
+/*--------------------------------------------------------------------------*/
+/** Returns one of the float parameters of the algorithm.
+
+   @param par  is the parameter to return [see SetPar( double ) for
+               comments];
+
+   @param val  upon return, it will contain the value of the parameter.
+
+   Apart from the parameters of the base class, this method handles
+   kDeltaSt. */
+
+   void GetPar( int par , double &val ) const override {
+    if( par == kDeltaSt )
+     val = double( Delta );
+    else
+     MCFClass::GetPar( par , val );
+    }
+
 /*--------------------------------------------------------------------------*/
 /*-------------------- METHODS FOR SOLVING THE PROBLEM ---------------------*/
 /*--------------------------------------------------------------------------*/
@@ -227,8 +506,8 @@ class SPTree : public MCFClass
    - the node is *not* a destination and it cannot be reached from the Origin
      (however, this does *not* mean that the problem is unfeasible);
 
-   - if LABEL_SETTING == 1, the node is *not* a destination and it has not
-     been reached during the algorithm. */
+   - if the algorithm is label-setting, the node is *not* a destination and
+     it has not been reached during the algorithm. */
 
    cCRow MCFGetPi( void ) const override { return( Pi + 1 ); }
 
@@ -240,6 +519,14 @@ class SPTree : public MCFClass
 
    FONumber MCFGetFO( void ) const override { return( FO ); }
 
+/*--------------------------------------------------------------------------*/
+/** Same meaning as MCFClass::MCFGetMemory(). The optional data structures
+   (reverse graph and SPTree of the bidirectional search, landmarks of the
+   ALT algorithm, data of the incremental repair) are counted in Extra. The
+   worker copies of SPTBatch() are temporaries, and are not counted. */
+
+   MCFMemory MCFGetMemory( void ) const override;
+
 /*--------------------------------------------------------------------------*/
 /*-------------- METHODS FOR READING THE DATA OF THE PROBLEM ---------------*/
 /*--------------------------------------------------------------------------*/
@@ -353,7 +640,14 @@ class SPTree : public MCFClass
     Index nde = Startn[ name ];   // start node of arc name
     return( pos < StrtFS[ nde ] + LenFS[ nde ] );
    #else
-    return( false );
+    // with kDynTopo, the closed (and deleted) arcs are out of the stars,
+    // the deleted ones being marked by a 0 head
+
+    if( ! DynT )
+     return( false );
+
+    cIndex pos = DictM1[ DirSPT ? name : 2 * name ];
+    return( ( pos >= StrtFS[ n + 1 ] ) && FS[ pos ].Nde );
    #endif
    }
 
@@ -381,6 +675,16 @@ class SPTree : public MCFClass
 /*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -*/
 
   bool IsDeletedArc( Index name ) const override {
+   #if( ! DYNMC_MCF_SPT )
+    if( DynT ) {
+     if( name >= m )
+      return( true );
+
+     cIndex pos = DictM1[ DirSPT ? name : 2 * name ];
+     return( ( pos >= StrtFS[ n + 1 ] ) && ( ! FS[ pos ].Nde ) );
+     }
+   #endif
+
    return( SPTree::IsClosedArc( name ) );
    }
 
@@ -397,18 +701,89 @@ class SPTree : public MCFClass
 /**< Solver of the Shortest Path Tree Problem from the current Origin.
    (specified in the constructor or by SetOrigin(), see below)
 
-   If LABEL_SETTING == 0, or if no Destination is speficied (Dst ==
+   If the algorithm is label-correcting, or if no Destination is speficied (Dst ==
    Inf< Index >() in SetDest() [see below]), the whole Shortest Path Tree (at
    least, the SPT of the component of the graph connected with Origin) is
    computed, otherwise the code stops as soon as the shortest path between
    Origin and Dest is computed.
 
+   If SetPar( kBiDirect , kYes ) has been called, the algorithm is
+   label-setting and a Dest is specified, the shortest path is computed by
+   a bidirectional search: a backward search from Dest on the reverse graph
+   (which is built once, when first needed, and then kept updated) is run
+   alternatively with the forward one from Origin, until the two meet.
+   Upon return, Pi[] and Predecessors() are correct for all the nodes that
+   have been scanned by the forward search and for all the nodes in the
+   shortest path between Origin and Dest, which all are Reached(), while
+   all the other nodes have Inf< CNumber >() potential; hence, calling
+   ShortestPathTree() again with another Dest recomputes everything from
+   scratch, and so does SolveMCF() if there is more than one destination,
+   in which case the bidirectional search is not used.
+
+   If landmarks have been set [see SetLandmarks()], the algorithm is
+   label-setting and a Dest is specified, the shortest path is instead
+   computed by the A* algorithm using the landmark lower bounds; upon
+   return the semantic is the same as for the unidirectional search. As
+   for the bidirectional search, A* is only used when the computation
+   starts from scratch, and by SolveMCF() if there is only one destination.
+   The Bucket algorithm uses Heap for A*, since the reduced costs may not
+   be small enough.
+
+   If SetPar( kIncrmntl , kYes ) has been called, once a complete Shortest
+   Path Tree has been computed (with no Dest, or by a label-correcting
+   algorithm, or by SolveMCF(), which then always computes the whole tree)
+   the following changes of the arc costs are recorded, and the next call
+   repairs the tree in the style of Ramalingam and Reps: the heads of the
+   arcs whose cost has decreased are put in Q, while the subtrees hanging
+   from the tree arcs whose cost has increased are detached, and their
+   nodes are put in Q with the best label given by the rest of the tree
+   (found using the reverse graph, which is built once, when first needed,
+   if the graph is directed). Thus, only the part of the graph affected by
+   the changes is scanned, and the whole Shortest Path Tree is available
+   upon return irrespective of Dest. The tree is instead recomputed from
+   scratch if the Origin has changed, or if more than n costs of arcs
+   have changed (those of undirected graphs counting twice), or if the
+   subtrees to be detached contain more than half of the nodes. The
+   label-setting algorithms all use Heap for the repair, since many nodes
+   may be put in Q at once, with labels too far apart for Bucket.
+
    Note that methods such as MCFGetX(), MCFGetRC() and MCFGetFO() may need
    some complicate calculations in order to put the solution of the Shortest
    Path in the correct format; since these calculations change some of the
    internal data structures, it is not permitted to call again
    ShortestPathTree() after that any of these methods have been called. */
 
+/*--------------------------------------------------------------------------*/
+
+   void SetLandmarks( Index k , cIndex_Set Lmrks = 0 , Index NThr = 0 );
+
+/**< Sets k landmarks for the ALT (A*, Landmarks, Triangle inequality)
+   algorithm, which is then used for Origin-Dest shortest paths [see
+   ShortestPathTree()]. If Lmrks != 0, its first k entries are the names of
+   the landmarks (as in SetOrigin()), otherwise they are chosen by the
+   "farthest" heuristic: each new landmark is the node farthest from the
+   closest of the previous ones. The distances from each landmark to all
+   the nodes (and, if the graph is directed, from all the nodes to each
+   landmark) are computed with SPTBatch() using NThr threads (0 = as many
+   as the hardware supports); with the "farthest" heuristic, the former
+   ones are computed sequentially while choosing the landmarks.
+
+   Changing costs keeps the distances usable as long as they give valid
+   lower bounds, which is always the case for cost increases; if this is
+   not so, they are automatically recomputed (for the same landmarks) in
+   the next ShortestPathTree() that uses them. LoadNet() removes the
+   landmarks, as does SetLandmarks( 0 ). */
+
+/*--------------------------------------------------------------------------*/
+/// returns the number of landmarks [see SetLandmarks()]
+
+   Index NLandmarks( void ) const { return( NLmk ); }
+
+/*--------------------------------------------------------------------------*/
+/// returns the NLandmarks()-vector of the names of the landmarks
+
+   cIndex_Set Landmarks( void ) const { return( Lmk ); }
+
 /*--------------------------------------------------------------------------*/
 /// Changes the Origin from which Shortest Paths are computed.
 
@@ -420,7 +795,22 @@ class SPTree : public MCFClass
     }
 
 /*--------------------------------------------------------------------------*/
-/** Changes the Destination node of Shotest Paths. If LABEL_SETTING == 0, it
+/// returns true if the current SPT algorithm is label-setting
+
+   bool LabelSetting( void ) const {
+    return( ( SPTAlg >= kDijkstra ) && ( SPTAlg <= kBucket ) );
+    }
+
+/*--------------------------------------------------------------------------*/
+/** Returns true if all the arc costs are integer numbers in
+   0 ... SPT_BKT_MAXC, and therefore the Bucket algorithm can be used; if
+   this is not the case, the Bucket algorithm uses the Heap one instead. */
+
+   bool BucketCosts( void ) const { return( ! NNBCst ); }
+
+/*--------------------------------------------------------------------------*/
+/** Changes the Destination node of Shotest Paths. If the algorithm is
+   label-correcting [see LabelSetting() above], it
    has no influence since label correcting methods cannot stop before the
    whole SPT has been computed. Conversely, label setting algorithms can solve
    Origin-Dest Shortest Path Problems; therefore, it is possible to obtain
@@ -436,9 +826,7 @@ class SPTree : public MCFClass
 
    void SetDest( Index NewDst ) {
     if( Dest != NewDst + USENAME0 ) {
-     #if( LABEL_SETTING )
-      Dest = NewDst + USENAME0;
-     #endif
+     Dest = NewDst + USENAME0;
      status = MCFClass::kUnSolved;
      }
     }
@@ -467,7 +855,7 @@ class SPTree : public MCFClass
 
 /*--------------------------------------------------------------------------*/
 /** Returns true if a shortest path from Origin to i have already been
-   computed; this can be used when LABEL_SETTING == 1 to determine if a
+   computed; this can be used with label-setting algorithms to determine if a
    shortest from Origin to i have been obtained as a by-product of the
    calculation of the shortest path between Origin and some other Dest. */
 
@@ -514,6 +902,11 @@ class SPTree : public MCFClass
 
    cIndex_Set Dests( void ) const { return( DstBse ); }
 
+/*--------------------------------------------------------------------------*/
+/// returns true if the graph is directed [see the constructor]
+
+   bool Directed( void ) const { return( DirSPT ); }
+
 /*--------------------------------------------------------------------------*/
 /// returns the size of the Forward Star of node i
 
@@ -532,6 +925,66 @@ class SPTree : public MCFClass
     return( Dict[ StrtFS[ i ] + h ] );
     }
 
+/*--------------------------------------------------------------------------*/
+
+   void SPTBatch( Index NOrg , cIndex_Set Orgs , CRow Dist ,
+		  Index_Set Prd = 0 , const cIndex_Set *Dsts = 0 ,
+		  Index NThr = 0 );
+
+/**< Computes the Shortest Path Trees rooted at each of the NOrg nodes in
+   Orgs[] (names as in SetOrigin()), distributing them among NThr threads
+   (0 = as many as the hardware supports). The graph is shared by all the
+   threads, each one having its own Pi[], NdePrd[], Q[] ...; this object
+   is not modified, hence its current solution (if any) is retained.
+
+   If Dsts != 0 and Dsts[ k ] != 0, then Dsts[ k ] is the Inf< Index >()-
+   terminated set of the destinations (names as in SetDest()) of the k-th
+   origin: if the algorithm is label-setting, the computation for that
+   origin stops as soon as all of them have been reached. Otherwise, the
+   whole SPT is computed.
+
+   Upon return, if Dist != 0 then Dist[ k * n + i ] is the distance from
+   the k-th origin to node i + 1 - USENAME0 (i.e., the k-th row of the
+   matrix is what MCFGetPi() would return), and if Prd != 0 then
+   Prd[ k * n + i ] is the predecessor of the same node in the SPT, with
+   the same naming of Predecessors(). Nodes that have not been reached
+   (either because there is no path to them or because the computation
+   has been stopped earlier) have Inf< CNumber >() distance and 0
+   predecessor.
+
+   The stop conditions of this object (MCFStop(), SetMCFToken() and
+   SetMCFDeadline()) apply to all the threads: once any of them holds, the
+   SPT of the origins not completed yet are only partly computed. */
+
+/*- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -*/
+
+   void SPTBatch( Index NOrg , cIndex_Set Orgs , const SPTBatchFunc &Func ,
+		  const cIndex_Set *Dsts = 0 , Index NThr = 0 );
+
+/**< As SPTBatch( ... , CRow , ... ) above, except that rather than being
+   written in matrices, the solution for each origin is passed to Func
+   [see SPTBatchFunc] as soon as it is available. */
+
+/*--------------------------------------------------------------------------*/
+
+   void SPTMatrix( Index NOrg , cIndex_Set Orgs , Index NDst ,
+		   cIndex_Set Dsts , CRow Dist , Index NThr = 0 );
+
+/**< Computes the distances from each of the NOrg nodes in Orgs[] (names as
+   in SetOrigin()) to each of the NDst nodes in Dsts[] (names as in
+   SetDest()): upon return, Dist[ k * NDst + h ] is the length of the
+   shortest path from Orgs[ k ] to Dsts[ h ], or Inf< CNumber >() if there
+   is no such path, i.e., Dist[] is the dense row-major origin x
+   destination matrix.
+
+   This is SPTBatch() with Dsts[] as the destinations of every origin:
+   the origins are distributed among NThr threads (0 = as many as the
+   hardware supports), and if the algorithm is label-setting the
+   computation for each origin stops as soon as all of Dsts[] have been
+   reached. If the arc costs do not change between many such calls,
+   building a CHTree from this object and using CHTree::Matrix() is
+   usually much faster. */
+
 /*--------------------------------------------------------------------------*/
 /*------------------------------ DESTRUCTOR --------------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -602,32 +1055,168 @@ class SPTree : public MCFClass
 
 /*--------------------------------------------------------------------------*/
 
+   struct LQueue;
+   struct LDeque;
+   struct Dijkstra;
+   template< Index HC > struct Heap;
+   struct Bucket;
+
+/* The "policies" implementing the set Q for each SPT algorithm: each one
+   provides the static methods ExtractQ(), extracting an element (depending
+   on the particular algoritm) from Q and returning 0 if Q is empty, and
+   InsertQ(), inserting a node with a given (old and new) label somewhere in
+   Q, together with the static constants LblSttng, telling whether the
+   algorithm is label-setting, and ChckQ, telling whether a node must not be
+   inserted in Q if it already is there. Heap< 0 > uses the ariety HeapC,
+   Heap< C > for C > 0 has the ariety fixed to C. */
+
+/*--------------------------------------------------------------------------*/
+
+   int Algrtm( void ) const {
+    if( ( SPTAlg == kBucket ) && NNBCst )
+     return( kHeap );
+
+    return( ( SPTAlg == kDelta ) && NNgCst ? int( kLQueue ) : SPTAlg );
+    }
+
+/* The SPT algorithm that is actually used, i.e., SPTAlg unless this is
+   Bucket and the costs are not suitable for it, or Delta and some cost is
+   negative. */
+
+/*--------------------------------------------------------------------------*/
+
+   void SPTSearch( bool P2P );
+
+/* The actual ShortestPathTree(), using either A* or the bidirectional
+   search if P2P is true (and this makes sense), or repairing the current
+   tree if possible. */
+
+/*--------------------------------------------------------------------------*/
+
+   bool IncRepair( void );
+
+   template< class P > void IncLoop( cIndex NAff );
+
+   template< class P > void IncRelax( cIndex u , cIndex pos );
+
+/* IncRepair() repairs the current (complete) SPT after the cost changes
+   recorded in IncChg[], returning false if this cannot be done. It
+   detaches the subtrees of the tree arcs whose cost has increased, putting
+   their NAff nodes in IncAff[], then IncLoop() puts in Q all the nodes
+   whose label can decrease, using IncRelax() to relax the arc in position
+   pos of FS[], whose tail is u, and runs the main cycle with policy P. */
+
+/*--------------------------------------------------------------------------*/
+
+   template< class P > void SPTLoop( void );
+
+/* The main cycle of the SPT algorithm with policy P. */
+
+/*--------------------------------------------------------------------------*/
+
+   template< class P > void BiSPTLoop( void );
+
+/* The main cycle of the bidirectional search with policy P. */
+
+/*--------------------------------------------------------------------------*/
+
+   template< class P > void ALTLoop( void );
+
+/* The main cycle of A* with policy P, using the landmark lower bounds. */
+
+/*--------------------------------------------------------------------------*/
+
+   void MakeRev( void );
+
+   void DelRev( void );
+
+   Index FwdPos( cIndex rpos ) const;
+
+   void SyncRev( void );
+
+/* MakeRev() constructs the Reverse Star and the SPTree RevT used for the
+   backward search, DelRev() deletes them. FwdPos() returns the position in
+   FS[] of the arc that is in position rpos of the Reverse Star. SyncRev()
+   copies the algorithmic parameters into RevT. */
+
+/*--------------------------------------------------------------------------*/
+
+   void CalcLmk( CRow T );
+
+   void DelLmk( void );
+
+   CNumber LmkBound( cIndex i ) const;
+
+   bool LmkFsbl( cIndex u , cIndex v , cCNumber c ) const;
+
+/* CalcLmk() computes the landmark distances into LmkDF[] and LmkDR[]; if
+   T != 0, it already contains the distances from the landmarks, as rows of
+   a NLmk x n matrix. DelLmk() deletes the landmarks. LmkBound() returns
+   the lower bound on the distance between i and Dest (Inf< CNumber >() if
+   Dest cannot be reached from i). LmkFsbl() tells if the landmark
+   distances still give valid bounds if the cost of arc ( u , v ) is
+   decreased to c. */
+
+/*--------------------------------------------------------------------------*/
+
+   template< class P > void ScanFS( cIndex mi );
+
    void ScanFS( cIndex mi );
 
 /* Scans the Forward Star of mi and puts in Q those nodes whose distance
-   label can be decreased by using an arc emanating from mi. */
+   label can be decreased by using an arc emanating from mi; the second
+   version calls the first with the policy of the current algorithm. */
 
 /*--------------------------------------------------------------------------*/
 
-   Index ExtractQ( void );
+   SPTree( const SPTree &Mstr , bool Stop );
 
-/* Extracts an element (depending on the particular algoritm) from the set Q:
-   if Q is empty, returns 0. */
+/* Constructs a "worker" copy of Mstr for SPTBatch(), that shares with Mstr
+   all the (read-only) data describing the graph, while having its own
+   data structures for the SPT computation. If Stop == true the worker also
+   gets the stop conditions of Mstr (MCFStop(), token and deadline). */
 
 /*--------------------------------------------------------------------------*/
 
-#if( ( SPT_ALGRTM == 0 ) || ( SPT_ALGRTM == 3 ) )
+   struct BatchJob;
 
-   void InsertQ( cIndex j );
+   void BatchSolve( cIndex Org , cIndex_Set Dsts );
 
-#else
+   void LmkBatch( Index NOrg , cIndex_Set Orgs , CRow Dist ,
+		  Index NThr ) const;
 
-   void InsertQ( cIndex j , cCNumber label );
+/* BatchJob describes a call to SPTBatch(), and distributes the origins
+   among the threads. BatchSolve(), called on a worker copy, computes the
+   SPT from the origin Org, stopping once all the destinations in Dsts (if
+   Dsts != 0) have been reached. LmkBatch() is SPTBatch( ... , Dist ) for
+   the distances of the landmarks, that must be complete, hence ignoring
+   the stop conditions of this object. */
 
-#endif
+/*--------------------------------------------------------------------------*/
+
+   struct DeltaJob;
+
+   void DeltaLoop( void );
 
-/* Inserts the node with name j and label label somewhere in Q: the label is
-   not needed for LQueue and Djkstra algorithms. */
+/* DeltaJob holds the (shared) data of the Delta algorithm and runs its
+   threads, DeltaLoop() is its main cycle. */
+
+/*--------------------------------------------------------------------------*/
+
+   void Relayout( void );
+
+   void DynOut( cIndex k , cIndex i );
+
+   void DynIn( cIndex k , cIndex i );
+
+/* Relayout() rebuilds the Forward Star, removing the free positions if
+   DynT == false, or giving each FS( i ) some free positions at its end
+   otherwise, in which case the arcs out of the stars (closed or deleted)
+   are put in fixed positions after StrtFS[ n + 1 ], that of the k-th
+   entry of DictM1[] being StrtFS[ n + 1 ] + k. DynOut() moves the k-th
+   entry of DictM1[] from FS( i ) to its fixed position, DynIn() moves it
+   back to FS( i ), rebuilding the Forward Star if there is no room; both
+   can change the position of all the arcs. */
 
 /*--------------------------------------------------------------------------*/
 
@@ -635,6 +1224,27 @@ class SPTree : public MCFClass
 
 /* Calculates the ArcPrd[] vector. */
 
+/*--------------------------------------------------------------------------*/
+
+   Index Tail( cIndex pos ) const;
+
+/* Returns the tail node of the arc in position pos of FS[]. */
+
+/*--------------------------------------------------------------------------*/
+
+   static bool BktCst( cCNumber c ) {
+    return( ( c >= 0 ) && ( c <= SPT_BKT_MAXC ) && ( c == std::floor( c ) ) );
+    }
+
+   void CntBktCst( void );
+
+   void SetCst( cIndex pos , cCNumber c );
+
+/* BktCst() tells if c can be the cost of an arc for the Bucket algorithm.
+   CntBktCst() computes from scratch NNBCst, NNgCst and MaxCst, while
+   SetCst() sets the cost of the arc in position pos of FS[] to c updating
+   them. */
+
 /*--------------------------------------------------------------------------*/
 
    void MemAlloc( void );
@@ -654,18 +1264,30 @@ class SPTree : public MCFClass
                      // been updated after a "final" ShortestPathTree() call 
  FrwdStr FS;         // the Forward Star (itself)
 
+ int SPTAlg;         // the SPT algorithm [see SPTAlgrtm]
+ Index HeapC;        // the ariety of the heap
+
  Index_Set Q;        // the set of scanned nodes: Q[ i ] = INF ==> i \notin Q
- #if( SPT_ALGRTM <= 3 )
-                     // here, Q is an array pointer implementation of a list,
-                     // and *Q is the head of the list (node names are >= 1)
- #else
-  Index_Set H;       // here, Q[ i ] tells the position of node i in the
-		     // vector implementing the heap, and H is that vector
- #endif
+                     // for lists, Q is an array pointer implementation of a
+                     // list, and *Q is the head of the list (node names are
+		     // >= 1); for the heap, Q[ i ] tells the position of
+ Index_Set H;        // node i in the vector implementing the heap, and H is
+		     // that vector; for the buckets, Q[ i ] and H[ i ] are
+		     // the next and previous node in the bucket of i
 
  Index cFS;          // cardinality of the FS (m if DirSPT, 2m otherwise)
  Index tail;         // the tail element of the list, or the first free
-                     // position in the heap
+                     // position in the heap, or the number of nodes in
+                     // the buckets
+
+ Index NNBCst;       // number of arc costs not suitable for Bucket
+ CNumber MaxCst;     // (upper bound on) the largest arc cost if NNBCst == 0
+ Index NNgCst;       // number of negative arc costs (not suitable for Delta)
+ Index_Set Bkt;      // the buckets: Bkt[ b ] = first node in the bucket, for
+ Index BktDim;       // b = 0 ... NBkt - 1 (NBkt <= BktDim = size of Bkt[]),
+ Index NBkt;         // the list being in Q[] (next) and H[] (previous)
+ Index BktCur;       // the current bucket ...
+ CNumber BktD;       // ... and the corresponding label
 
  Index_Set Startn;
  Index_Set StrtFS;   // position in FS[] where FS[ i ] begins
@@ -680,6 +1302,47 @@ class SPTree : public MCFClass
 		     // consecutive entries 2 * i and 2 * i + 1 tells the
 		     // two positions of arc i in FS[]
  bool DirSPT;        // true if the graph is directed
+ bool Shrd;          // true if the graph data is owned by another SPTree,
+                     // i.e., this is a worker copy for SPTBatch()
+
+ bool BiDir;         // true if the bidirectional search is used
+ SPTree *RevT;       // the SPTree for the backward search (if any)
+ FrwdStr RFS;        // the Reverse Star, i.e., the Forward Star of the
+ Index_Set RStrtFS;  // reverse graph, with RStrtFS[], RDict[] and RDictM1[]
+ Index_Set RDict;    // having the same meaning as StrtFS[], Dict[] and
+ Index_Set RDictM1;  // DictM1[] (only if DirSPT, as otherwise the graph is
+                     // its own reverse and FS[] is used)
+
+ Index NLmk;         // number of landmarks (0 = ALT not used)
+ Index_Set Lmk;      // the landmarks (names as in SetOrigin())
+ CRow LmkDF;         // LmkDF[ ( i - 1 ) * NLmk + l ] = distance from the
+                     // l-th landmark to node i, and LmkDR[] the same for
+ CRow LmkDR;         // the distance from i to the landmark (== LmkDF if the
+                     // graph is undirected)
+ CRow LmkH;          // lower bounds on the distance to Dest (< 0 = not yet
+                     // computed), 1 ... n
+ bool LmkOK;         // false if the distances must be recomputed
+ Index LmkThr;       // the number of threads for computing them
+
+ bool Incr;          // true if the SPT is repaired after cost changes
+ bool Full;          // true if the current SPT is complete and correct,
+                     // apart from the changes recorded in IncChg[]
+ Index IncOrg;       // the Origin of the current SPT
+ Index_Set IncChg;   // positions in FS[] of the arcs whose cost has changed
+ Index IncN;         // since the SPT was computed, and their number
+ Index_Set IncAff;   // the nodes whose label has to be recomputed
+
+ bool Rsm;           // true if the latest search has been stopped within
+                     // SPTLoop(), and therefore it can be resumed
+
+ bool DynT;          // true if the topology can be changed [see kDynTopo]
+ Index_Set DLen;     // if DynT, the number of arcs in each FS( i ), the
+                     // rest of it being free positions
+ Index NLive;        // if DynT, the total number of arcs in the stars
+ Index FrstDel;      // if DynT, all the arcs < FrstDel are not deleted
+
+ CNumber Delta;      // the width of the buckets of Delta (0 = automatic)
+ Index DeltaThr;     // the number of threads of Delta (0 = hardware)
 
 /*--------------------------------------------------------------------------*/
 